@@ -0,0 +1,405 @@
+/*
+endian_bench.cpp: Benchmark for endian.hpp
+Copyright (C) 2016-2018 Ivan G. / nekotekina@gmail.com
+This file may be modified and distributed under the terms of the MIT license (see endian.hpp).
+*/
+
+// Build: cmake -S bench -B build && cmake --build build (or g++ -O2 -I. bench/endian_bench.cpp)
+// Usage: endian_bench [filter] -- run only cases which names contain `filter` (for example "u32" or "bulk")
+// Prints time per element (ns), cycles per element (TSC reference cycles, x86 only) and throughput (GB/s) of
+// LE/BE storage processed. Every case is repeated, the best repetition is reported.
+// Scalar cases (get/set/compound ops, le_store/be_load) run on L1-resident arrays for sizes 1, 2, 4, 8, 16
+// and alignments 1, natural and over-aligned (2x natural). Alignment 1 is also run on unaligned buffers.
+// Bulk cases compare element-wise loop (scalar) with be_copy_n/be_store_n (bulk) on aligned/unaligned buffers.
+// Stream cases compare bulk_store::temporal and bulk_store::streaming for cache-sized and memory-sized arrays,
+// "then read" lines show the time to read a cache-sized working set after the conversion (evicted or not).
+
+#include "endian.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+	using uchar = unsigned char;
+
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 uint128;
+#endif
+
+	const char* g_filter = "";
+
+	// Prevent the compiler from removing computation of value
+	template <typename T>
+	inline void keep(const T& value)
+	{
+#if defined(__GNUC__)
+		__asm__ __volatile__("" : : "m"(value) : "memory");
+#else
+		static volatile T sink;
+		sink = value;
+#endif
+	}
+
+	// Prevent the compiler from removing stores
+	inline void clobber()
+	{
+#if defined(__GNUC__)
+		__asm__ __volatile__("" : : : "memory");
+#else
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+	}
+
+	inline std::uint64_t cycles()
+	{
+#if defined(ENDIAN_X86)
+		return __rdtsc();
+#else
+		return 0;
+#endif
+	}
+
+	// Zero-filled storage aligned to 64 bytes, get(offset) returns pointer `offset` bytes after alignment
+	class buffer
+	{
+		std::vector<uchar> m_data;
+
+	public:
+		explicit buffer(std::size_t size)
+			: m_data(size + 128)
+		{
+		}
+
+		uchar* get(std::size_t offset = 0)
+		{
+			return m_data.data() + (64 - reinterpret_cast<std::uintptr_t>(m_data.data()) % 64) % 64 + offset;
+		}
+	};
+
+	template <typename... Args>
+	std::string format(const char* fmt, Args... args)
+	{
+		char buf[128];
+		std::snprintf(buf, sizeof(buf), fmt, args...);
+		return buf;
+	}
+
+	// Run f() which processes n elements (bytes of storage) and print the best of several repetitions
+	template <typename F>
+	void run(const std::string& name, std::size_t n, std::size_t bytes, F&& f)
+	{
+		if (name.find(g_filter) == std::string::npos)
+		{
+			return;
+		}
+
+		using clock = std::chrono::steady_clock;
+
+		// Calibrate number of iterations for approximately 20 ms per repetition
+		std::size_t iters = 1;
+
+		for (;; iters *= 2)
+		{
+			const auto start = clock::now();
+
+			for (std::size_t i = 0; i < iters; i++)
+			{
+				f();
+			}
+
+			if (clock::now() - start >= std::chrono::milliseconds(20) || iters >= std::size_t{1} << 30)
+			{
+				break;
+			}
+		}
+
+		double best_ns = 1e300;
+		double best_cycles = 0;
+
+		for (int rep = 0; rep < 5; rep++)
+		{
+			const auto start = clock::now();
+			const std::uint64_t start_cycles = cycles();
+
+			for (std::size_t i = 0; i < iters; i++)
+			{
+				f();
+			}
+
+			const std::uint64_t end_cycles = cycles();
+			const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+			if (ns < best_ns)
+			{
+				best_ns = ns;
+				best_cycles = static_cast<double>(end_cycles - start_cycles);
+			}
+		}
+
+		const double elements = static_cast<double>(iters) * static_cast<double>(n);
+		std::printf("%-44s %10.3f %12.3f %10.2f\n", name.c_str(), best_ns / elements, best_cycles / elements, static_cast<double>(bytes) * static_cast<double>(iters) / best_ns);
+	}
+
+	// Same as run(), but only f() is timed (best of 20), setup() is called before every f()
+	template <typename S, typename F>
+	void run_after(const std::string& name, std::size_t n, std::size_t bytes, S&& setup, F&& f)
+	{
+		if (name.find(g_filter) == std::string::npos)
+		{
+			return;
+		}
+
+		using clock = std::chrono::steady_clock;
+
+		double best_ns = 1e300;
+		double best_cycles = 0;
+
+		for (int rep = 0; rep < 20; rep++)
+		{
+			setup();
+
+			const auto start = clock::now();
+			const std::uint64_t start_cycles = cycles();
+			f();
+			const std::uint64_t end_cycles = cycles();
+			const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+			if (ns < best_ns)
+			{
+				best_ns = ns;
+				best_cycles = static_cast<double>(end_cycles - start_cycles);
+			}
+		}
+
+		const double elements = static_cast<double>(n);
+		std::printf("%-44s %10.3f %12.3f %10.2f\n", name.c_str(), best_ns / elements, best_cycles / elements, static_cast<double>(bytes) / best_ns);
+	}
+
+	// endian_base get/set/compound ops (E is le_t<T, A> or be_t<T, A>)
+	template <typename E, typename T, std::size_t A>
+	void bench_ops(const char* order, const char* type, std::size_t offset)
+	{
+		constexpr std::size_t n = 2048;
+		constexpr std::size_t bytes = n * sizeof(E);
+
+		buffer buf(bytes);
+		const char* where = offset ? "unaligned" : "aligned";
+
+		E* data = reinterpret_cast<E*>(buf.get(offset));
+
+		run(format("%s<%s, %zu> get, %s", order, type, A, where), n, bytes, [&] {
+			T sum = 0;
+
+			for (std::size_t i = 0; i < n; i++)
+			{
+				sum += data[i];
+			}
+
+			keep(sum);
+		});
+
+		run(format("%s<%s, %zu> set, %s", order, type, A, where), n, bytes, [&] {
+			for (std::size_t i = 0; i < n; i++)
+			{
+				data[i] = static_cast<T>(i);
+			}
+
+			clobber();
+		});
+
+		run(format("%s<%s, %zu> +=, %s", order, type, A, where), n, bytes, [&] {
+			for (std::size_t i = 0; i < n; i++)
+			{
+				data[i] += T(3);
+			}
+
+			clobber();
+		});
+
+		run(format("%s<%s, %zu> ^=, %s", order, type, A, where), n, bytes, [&] {
+			for (std::size_t i = 0; i < n; i++)
+			{
+				data[i] ^= T(0x55);
+			}
+
+			clobber();
+		});
+	}
+
+	template <typename T, std::size_t A>
+	void bench_scalar(const char* type, std::size_t offset)
+	{
+		bench_ops<std::be_t<T, A>, T, A>("be_t", type, offset);
+		bench_ops<std::le_t<T, A>, T, A>("le_t", type, offset);
+	}
+
+	// le_store/be_load on naturally aligned raw memory
+	template <typename T>
+	void bench_load_store(const char* type)
+	{
+		constexpr std::size_t n = 2048;
+		constexpr std::size_t bytes = n * sizeof(T);
+
+		buffer buf(bytes);
+		uchar* data = buf.get();
+
+		run(format("be_load<%s>", type), n, bytes, [&] {
+			T sum = 0;
+
+			for (std::size_t i = 0; i < n; i++)
+			{
+				sum += std::be_load<T>(data + i * sizeof(T));
+			}
+
+			keep(sum);
+		});
+
+		run(format("le_store<%s>", type), n, bytes, [&] {
+			for (std::size_t i = 0; i < n; i++)
+			{
+				std::le_store(data + i * sizeof(T), static_cast<T>(i));
+			}
+
+			clobber();
+		});
+	}
+
+	// Element-wise loop vs bulk functions
+	template <typename T>
+	void bench_bulk(const char* type)
+	{
+		for (std::size_t bytes : {std::size_t{16} << 10, std::size_t{1} << 20})
+		{
+			for (std::size_t offset : {0, 1})
+			{
+				const std::size_t n = bytes / sizeof(T);
+				const char* where = offset ? "unaligned" : "aligned";
+
+				buffer sbuf(bytes), dbuf(bytes);
+				T* native = reinterpret_cast<T*>(dbuf.get());
+				uchar* raw = sbuf.get(offset);
+				std::be_t<T, 1>* packed = reinterpret_cast<std::be_t<T, 1>*>(raw);
+
+				run(format("copy %s %zuK scalar, %s", type, bytes >> 10, where), n, bytes, [&] {
+					for (std::size_t i = 0; i < n; i++)
+					{
+						native[i] = packed[i];
+					}
+
+					clobber();
+				});
+
+				run(format("copy %s %zuK bulk, %s", type, bytes >> 10, where), n, bytes, [&] {
+					std::be_copy_n(native, raw, n);
+					clobber();
+				});
+
+				run(format("store %s %zuK scalar, %s", type, bytes >> 10, where), n, bytes, [&] {
+					for (std::size_t i = 0; i < n; i++)
+					{
+						packed[i] = native[i];
+					}
+
+					clobber();
+				});
+
+				run(format("store %s %zuK bulk, %s", type, bytes >> 10, where), n, bytes, [&] {
+					std::be_store_n(raw, native, n);
+					clobber();
+				});
+
+				run(format("memcpy %s %zuK, %s", type, bytes >> 10, where), n, bytes, [&] {
+					std::memcpy(native, raw, bytes);
+					clobber();
+				});
+			}
+		}
+	}
+
+	// Temporal vs non-temporal (streaming) stores of be_copy_n: conversion throughput, and the cost of reading
+	// a working set (which should stay in cache) right after the conversion
+	void bench_stream()
+	{
+		using T = std::uint32_t;
+
+		constexpr std::size_t ws_bytes = 512 << 10;
+		buffer wbuf(ws_bytes);
+		const T* ws = reinterpret_cast<const T*>(wbuf.get());
+
+		const auto read_ws = [&] {
+			T sum = 0;
+
+			for (std::size_t i = 0; i < ws_bytes / sizeof(T); i++)
+			{
+				sum += ws[i];
+			}
+
+			keep(sum);
+		};
+
+		for (std::size_t bytes : {std::size_t{1} << 20, std::size_t{64} << 20})
+		{
+			const std::size_t n = bytes / sizeof(T);
+
+			buffer sbuf(bytes), dbuf(bytes);
+			T* dst = reinterpret_cast<T*>(dbuf.get());
+			const uchar* src = sbuf.get();
+
+			for (std::bulk_store mode : {std::bulk_store::temporal, std::bulk_store::streaming})
+			{
+				const char* mname = mode == std::bulk_store::temporal ? "temporal" : "streaming";
+
+				run(format("stream u32 %zuK copy, %s", bytes >> 10, mname), n, bytes, [&] {
+					std::be_copy_n(dst, src, n, mode);
+					clobber();
+				});
+
+				run_after(format("stream u32 %zuK then read %zuK, %s", bytes >> 10, ws_bytes >> 10, mname), ws_bytes / sizeof(T), ws_bytes, [&] {
+					read_ws();
+					std::be_copy_n(dst, src, n, mode);
+					clobber();
+				}, read_ws);
+			}
+		}
+	}
+
+	template <typename T>
+	void bench_type(const char* type)
+	{
+		bench_scalar<T, 1>(type, 0);
+		bench_scalar<T, 1>(type, 1);
+
+		if (alignof(T) > 1)
+		{
+			bench_scalar<T, alignof(T)>(type, 0);
+		}
+
+		bench_scalar<T, alignof(T) * 2>(type, 0);
+		bench_load_store<T>(type);
+		bench_bulk<T>(type);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1)
+	{
+		g_filter = argv[1];
+	}
+
+	std::printf("%-44s %10s %12s %10s\n", "case", "ns/elem", "cycles/elem", "GB/s");
+
+	bench_type<std::uint8_t>("u8");
+	bench_type<std::uint16_t>("u16");
+	bench_type<std::uint32_t>("u32");
+	bench_type<std::uint64_t>("u64");
+#if defined(__SIZEOF_INT128__)
+	bench_type<uint128>("u128");
+#endif
+
+	bench_stream();
+
+	return 0;
+}
@@ -31,23 +31,161 @@ THE SOFTWARE.
 // Setting greater alignment works similar to alignas() and isn't very useful.
 // Setting small alignment (especially 1) is the alternative to `#pragma pack`.
 
+// Generated code (GCC/Clang/MSVC, optimized build) for sizes 2, 4, 8 and 16:
+// Align == sizeof(T): value is stored as integer, load + bswap (rol for 2 bytes, two bswap for 16 bytes).
+// Align != sizeof(T): memcpy to naturally aligned temporary, which is optimized out (same code, unaligned load).
+// Other sizes: byte-by-byte copy (revert<Size>), 1 byte: plain copy.
+// Load/store + bswap is fused into MOVBE on x86 when compiling with -mmovbe (or -march supporting it),
+// into LWBRX/LDBRX on POWER and LDR + REV on ARM. Defining ENDIAN_MOVBE forces MOVBE on x86 (GCC/Clang)
+// with inline assembly for Align != sizeof(T), le_load/be_load and le_store/be_store, without changing -march.
+// Bulk functions (be_copy_n...) don't need it: they use SIMD shuffles (every CPU with MOVBE has SSSE3).
+
 // std::be_t<std::uint32_t> -- big endian uint32_t
 // std::le_t<std::uint32_t> -- little endian uint32_t
 // std::be_t<std::uint32_t, 2> -- big endian uint32_t with enforced alignment 2 (packing)
+// Bitwise compound ops (&=, |=, ^=), ==, != and test(mask) work on storage without byteswap when possible.
+// endian_base can be used in constant expressions if __builtin_bit_cast is available:
+// constexpr std::be_t<std::uint32_t> table[]{1, 2, 3}; -- constant initialization (no dynamic initializer)
+
+// std::be_copy_n(dst, src, n) -- load n big endian values into native array (bulk, SIMD)
+// std::be_store_n(dst, src, n) -- store n native values as big endian (bulk, SIMD)
+// std::le_copy_n, std::le_store_n -- same for little endian
+// (see endian_parallel.hpp for multithreaded versions)
+// Optional last argument std::bulk_store selects non-temporal stores for large arrays.
+// Defining ENDIAN_COUNTERS counts le_t/be_t byteswaps per type and per call site of get() and constructor
+// (compound ops are attributed to endian.hpp), reported at exit (std::endian_counters_at_exit sets a callback).
+// std::atomic_be_t<T>, std::atomic_le_t<T> -- atomic LE/BE types (std::atomic on storage)
+// std::be_vec<T, N>, std::le_vec<T, N> -- N LE/BE elements loaded/stored as SIMD vector (__m128i...) with byteswap
+// std::be_ptr<T, Base>, std::le_ptr<T, Base> -- 32-bit LE/BE offset from Base::base() (std::global_base<>, std::thread_base<>)
+// std::be_bitfield<Word, Offset, Width>, std::le_bitfield -- bit field of LE/BE word (for union with be_t<Word>)
+// std::be_reader, std::le_reader -- sequential reader (cursor), endian_reader<Order, false> is unchecked
+// std::be_writer, std::le_writer -- sequential writer (cursor), endian_writer<Order, false> is unchecked
+// std::endian_record<Fields...>::convert_n(dst, src, n) -- convert records of le_t/be_t fields (one shuffle per record)
+// std::byteswap_inplace(ptr, n) -- convert array of le_t/be_t to native values in place
+// std::native_view<be_t<T>> view(ptr, n) -- converted in place for the lifetime of the view (T* access)
+// std::be_uint24_t, std::be_int48_t... std::endian_int<Bits, Signed, Native> -- packed odd-width integers
+// std::be_unpack_n<24>(dst, src, n), std::le_unpack_n -- unpack packed odd-width integers into int32_t/int64_t array
+// std::is_wire_ready<T, Order>, std::serialize<Order>(dst, value), std::deserialize<Order, T>(src), std::wire_cast<Order, T>(ptr)
+// -- memcpy/pointer cast if layout is already in wire order, record conversion otherwise (T::endian_fields)
+// std::be_delta_decode_n(dst, src, n, init), std::be_delta_encode_n, std::le_... -- delta coding fused with byteswap
+// std::be_checksum16(ptr, size), std::be_checksum16_update(checksum, old, new) -- Internet checksum (RFC 1071, 1624)
+// std::crc32c_n(ptr, n), std::xxh64_n(ptr, n) -- CRC32C/XXH64 of LE/BE values without conversion pass
+// std::hash<endian_base<...>> -- hash of storage (no byteswap) for integers and enums
+// std::to_sortable_be(value) -- order-preserving BE key, std::radix_sort(ptr, n[, &R::key]) -- sort by LE/BE keys
+// std::be_gather(dst, base, stride, offset, n), std::be_scatter, std::be_gather_columns... -- strided AoS <-> SoA
+// std::be_t<std::half>, std::be_t<std::bfloat16> -- 16-bit floats, std::be_f16_to_f32_n, std::be_f32_to_f16_n... (F16C)
+// std::permuted_base<T, std::byte_order<...>> -- arbitrary byte permutation, std::pdp_t<T> (PDP-11), std::fpa_t<double>,
+// std::permuted_copy_n<Order>(dst, src, n), std::permuted_store_n -- bulk (pshufb)
+// (see endian_mapped.hpp for zero-copy views of LE/BE arrays in memory-mapped files)
+// (see endian_ranges.hpp for C++20 range adaptors std::views::from_be, std::views::to_be...)
+// (see endian_ingest.hpp for pipelined file/socket reads with overlapped conversion)
+// (see endian_cuda.hpp for CUDA/HIP device-side bulk conversion)
+// (see bench/endian_bench.cpp for benchmarks: cycles/element and GB/s of scalar and bulk conversion)
 
 #pragma once
 
 #include <type_traits>
+#include <utility>
 #include <cstdint>
 #include <cstring>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#define ENDIAN_X86
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ENDIAN_NEON
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+// Conversion counters (opt-in instrumentation, see endian_counters_dump)
+#if defined(ENDIAN_COUNTERS)
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<source_location>)
+#include <source_location>
+#endif
+#endif
+#endif
+
+// Constexpr support (requires bit_cast builtin)
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast) && __has_builtin(__builtin_is_constant_evaluated)
+#define ENDIAN_BIT_CAST
+#endif
+#endif
+#if !defined(ENDIAN_BIT_CAST) && defined(_MSC_VER) && _MSC_VER >= 1926
+#define ENDIAN_BIT_CAST
+#endif
+
+// CUDA/HIP: endian_base, le_load/be_store... are usable in device code (see endian_cuda.hpp for bulk kernels)
+#if defined(__CUDACC__) || defined(__HIPCC__)
+#define ENDIAN_HOST_DEVICE __host__ __device__
+#else
+#define ENDIAN_HOST_DEVICE
+#endif
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+#define ENDIAN_DEVICE_CODE
+#endif
+
+#if defined(ENDIAN_BIT_CAST)
+#define ENDIAN_CONSTEXPR ENDIAN_HOST_DEVICE constexpr
+#define ENDIAN_IS_CONSTEVAL() __builtin_is_constant_evaluated()
+#else
+#define ENDIAN_CONSTEXPR ENDIAN_HOST_DEVICE inline
+#define ENDIAN_IS_CONSTEVAL() false
+#endif
+
+// Runtime CPU dispatch for bulk functions (GCC/Clang only, otherwise selected at compile time)
+#if defined(ENDIAN_X86) && defined(__GNUC__)
+#define ENDIAN_X86_DISPATCH
+#define ENDIAN_TARGET(x) __attribute__((target(x)))
+#else
+#define ENDIAN_TARGET(x)
+#endif
+
+// Minimal size in bytes for automatic non-temporal stores in bulk functions
+#ifndef ENDIAN_STREAM_THRESHOLD
+#define ENDIAN_STREAM_THRESHOLD (std::size_t{16} << 20)
+#endif
+
+// Source prefetch distance in bytes for non-temporal bulk functions
+#ifndef ENDIAN_PREFETCH_DISTANCE
+#define ENDIAN_PREFETCH_DISTANCE 2048
+#endif
+
+#if defined(__GNUC__)
+#define ENDIAN_FORCEINLINE __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+#define ENDIAN_FORCEINLINE __forceinline
+#else
+#define ENDIAN_FORCEINLINE inline
+#endif
 
-namespace std
-{
-	// Class proposed in https://howardhinnant.github.io/endian.html
-	enum class endian
-	{
-		little,
-		big,
 // Detection from http://stackoverflow.com/questions/4239993/determining-endianness-at-compile-time
 #if defined(__BYTE_ORDER) && __BYTE_ORDER == __BIG_ENDIAN || \
     defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ || \
@@ -56,7 +194,6 @@ namespace std
     defined(__THUMBEB__) || \
     defined(__AARCH64EB__) || \
     defined(_MIBSEB) || defined(__MIBSEB) || defined(__MIBSEB__)
-		native = big,
 #ifndef __BIG_ENDIAN__
 #define __BIG_ENDIAN__
 #endif
@@ -68,27 +205,61 @@ namespace std
     defined(__AARCH64EL__) || \
     defined(_MIPSEL) || defined(__MIPSEL) || defined(__MIPSEL__) || \
     defined(_M_IX86) || defined(_M_X64) || defined(_M_IA64) || defined(_M_ARM)
-		native = little,
 #ifndef __LITTLE_ENDIAN__
 #define __LITTLE_ENDIAN__
 #endif
 #else
 #error "Unknown endianness"
+#endif
+
+namespace std
+{
+#if !defined(__cpp_lib_endian)
+	// Class proposed in https://howardhinnant.github.io/endian.html (standard since C++20, see <bit>)
+	enum class endian
+	{
+		little,
+		big,
+#ifdef __BIG_ENDIAN__
+		native = big,
+#else
+		native = little,
 #endif
 	};
+#endif
 
 	template <typename T>
 	struct has_endianness : std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value>
 	{
 	};
 
+#if defined(__SIZEOF_INT128__)
+	namespace detail
+	{
+		// __extension__ suppresses -Wpedantic warnings
+		__extension__ typedef __int128 int128_t;
+		__extension__ typedef unsigned __int128 uint128_t;
+	}
+
+	// Not arithmetic in strict ISO mode
+	template <>
+	struct has_endianness<detail::int128_t> : std::true_type
+	{
+	};
+
+	template <>
+	struct has_endianness<detail::uint128_t> : std::true_type
+	{
+	};
+#endif
+
 	namespace detail
 	{
 		using uchar = unsigned char;
 
 		// Copy with byteswap (fallback algorithm)
 		template <std::size_t Size>
-		inline void revert(uchar* dst, const uchar* src)
+		ENDIAN_CONSTEXPR void revert(uchar* dst, const uchar* src)
 		{
 			for (std::size_t i = 0; i < Size; i++)
 			{
@@ -96,86 +267,296 @@ namespace std
 			}
 		}
 
+		// Copy without byteswap (memcpy which can be used in constant expressions)
+		template <std::size_t Size>
+		ENDIAN_CONSTEXPR void copy_bytes(uchar* dst, const uchar* src)
+		{
+			if (ENDIAN_IS_CONSTEVAL())
+			{
+				for (std::size_t i = 0; i < Size; i++)
+				{
+					dst[i] = src[i];
+				}
+
+				return;
+			}
+
+			std::memcpy(dst, src, Size);
+		}
+
+		template <std::size_t Size>
+		struct byte_array
+		{
+			uchar data[Size];
+		};
+
+		// Unsigned integer type of given size (void if not available)
+		template <std::size_t Size>
+		struct uint_of_size
+		{
+			using type = void;
+		};
+
+		template <>
+		struct uint_of_size<1>
+		{
+			using type = std::uint8_t;
+		};
+
+		template <>
+		struct uint_of_size<2>
+		{
+			using type = std::uint16_t;
+		};
+
+		template <>
+		struct uint_of_size<4>
+		{
+			using type = std::uint32_t;
+		};
+
+		template <>
+		struct uint_of_size<8>
+		{
+			using type = std::uint64_t;
+		};
+
+#if defined(__SIZEOF_INT128__)
+		template <>
+		struct uint_of_size<16>
+		{
+			using type = uint128_t;
+		};
+#endif
+
+		// std::is_integral extended with 128-bit integers (not integral in strict ISO mode)
+		template <typename T>
+		struct is_integer : std::is_integral<T>
+		{
+		};
+
+#if defined(__SIZEOF_INT128__)
+		template <>
+		struct is_integer<int128_t> : std::true_type
+		{
+		};
+
+		template <>
+		struct is_integer<uint128_t> : std::true_type
+		{
+		};
+#endif
+
+		// Compound bitwise operations (used by endian_base)
+		struct op_and
+		{
+			template <typename T, typename T2>
+			static ENDIAN_CONSTEXPR void apply(T& lhs, T2&& rhs)
+			{
+				lhs &= std::forward<T2>(rhs);
+			}
+		};
+
+		struct op_or
+		{
+			template <typename T, typename T2>
+			static ENDIAN_CONSTEXPR void apply(T& lhs, T2&& rhs)
+			{
+				lhs |= std::forward<T2>(rhs);
+			}
+		};
+
+		struct op_xor
+		{
+			template <typename T, typename T2>
+			static ENDIAN_CONSTEXPR void apply(T& lhs, T2&& rhs)
+			{
+				lhs ^= std::forward<T2>(rhs);
+			}
+		};
+
+		template <typename To, typename From>
+		ENDIAN_CONSTEXPR To bit_cast(const From& src)
+		{
+			static_assert(sizeof(To) == sizeof(From), "bit_cast<>: size mismatch");
+#if defined(ENDIAN_BIT_CAST)
+			return __builtin_bit_cast(To, src);
+#else
+			To dst;
+			std::memcpy(&dst, &src, sizeof(To));
+			return dst;
+#endif
+		}
+
+		// Byteswap integer (fallback algorithm for constant expressions)
+		template <typename T>
+		ENDIAN_HOST_DEVICE constexpr T revert_int(T src, std::size_t i = 0)
+		{
+			return i == sizeof(T) ? T{0} : static_cast<T>((src >> (i * 8) & 0xff) << ((sizeof(T) - 1 - i) * 8) | revert_int(src, i + 1));
+		}
+
 		template <typename T, std::size_t Size = sizeof(T), std::size_t Align = 1>
 		struct alignas(Align) endian_buffer
 		{
 			using type = endian_buffer;
 
-			static constexpr bool can_opt = (Size == 2 || Size == 4 || Size == 8) && Align != Size;
+			static constexpr bool can_opt = (Size == 2 || Size == 4 || Size == 8 || Size == 16) && Align != Size;
 
-			static inline void put_re(type& dst, const T& src)
+			// Naturally aligned buffer if can_opt (this type otherwise)
+			using opt = endian_buffer<T, Size, can_opt ? Size : 1>;
+
+			// Load from unaligned memory with byteswap
+			static ENDIAN_CONSTEXPR T load_re(const uchar* src)
 			{
-				if (can_opt)
-				{
-					endian_buffer<T, Size, Size> buf_opt;
-					buf_opt.put_re(buf_opt, src);
-					std::memcpy(dst.data, &buf_opt, Size);
-					return;
-				}
+				byte_array<Size> bytes{};
+				revert<Size>(bytes.data, src);
+				return bit_cast<T>(bytes);
+			}
 
-				revert<Size>(dst.data, reinterpret_cast<const uchar*>(&src));
+			// Store to unaligned memory with byteswap
+			static ENDIAN_CONSTEXPR void store_re(uchar* dst, const T& src)
+			{
+				const auto bytes = bit_cast<byte_array<Size>>(src);
+				revert<Size>(dst, bytes.data);
 			}
 
-			static inline T get_re(const type& src)
+			static ENDIAN_CONSTEXPR void put_re(type& dst, const T& src)
 			{
-				if (can_opt)
-				{
-					endian_buffer<T, Size, Size> buf_opt;
-					std::memcpy(&buf_opt, src.data, Size);
-					return buf_opt.get_re(buf_opt);
-				}
+				opt::store_re(dst.data, src);
+			}
+
+			static ENDIAN_CONSTEXPR T get_re(const type& src)
+			{
+				return opt::load_re(src.data);
+			}
+
+			static ENDIAN_CONSTEXPR void put_ne(type& dst, const T& src)
+			{
+				const auto bytes = bit_cast<byte_array<Size>>(src);
+				copy_bytes<Size>(dst.data, bytes.data);
+			}
 
-				T dst;
-				revert<Size>(reinterpret_cast<uchar*>(&dst), src.data);
-				return dst;
+			static ENDIAN_CONSTEXPR T get_ne(const type& src)
+			{
+				byte_array<Size> bytes{};
+				copy_bytes<Size>(bytes.data, src.data);
+				return bit_cast<T>(bytes);
 			}
 
-			static inline void put_ne(type& dst, const T& src)
+			// Raw storage access (R: unsigned integer of the same size)
+			template <typename R>
+			static ENDIAN_CONSTEXPR R get_raw(const type& src)
 			{
-				std::memcpy(dst.data, reinterpret_cast<const uchar*>(&src), Size);
+				byte_array<Size> bytes{};
+				copy_bytes<Size>(bytes.data, src.data);
+				return bit_cast<R>(bytes);
 			}
 
-			static inline T get_ne(const type& src)
+			template <typename R>
+			static ENDIAN_CONSTEXPR void put_raw(type& dst, const R& src)
 			{
-				T dst;
-				std::memcpy(reinterpret_cast<uchar*>(&dst), src.data, Size);
-				return dst;
+				const auto bytes = bit_cast<byte_array<Size>>(src);
+				copy_bytes<Size>(dst.data, bytes.data);
 			}
 
 			uchar data[Size];
 		};
 
+#if defined(ENDIAN_MOVBE) && defined(ENDIAN_X86) && defined(__GNUC__) && !defined(__CUDACC__) && !defined(__HIPCC__)
+#define ENDIAN_MOVBE_ASM
+		// Byteswapping load/store with MOVBE instruction (opt-in, requires CPU support)
+		template <typename R>
+		inline R movbe_load(const uchar* src)
+		{
+			R result;
+			__asm__("movbe %1, %0" : "=r"(result) : "m"(*reinterpret_cast<const uchar(*)[sizeof(R)]>(src)));
+			return result;
+		}
+
+		template <typename R>
+		inline void movbe_store(uchar* dst, R value)
+		{
+			__asm__("movbe %1, %0" : "=m"(*reinterpret_cast<uchar(*)[sizeof(R)]>(dst)) : "r"(value));
+		}
+#endif
+
+#if defined(ENDIAN_DEVICE_CODE)
+		// Device byteswap (__byte_perm: PRMT instruction on NVIDIA, also provided by HIP)
+		__device__ inline std::uint16_t device_bswap(std::uint16_t src)
+		{
+			return static_cast<std::uint16_t>(__byte_perm(src, 0, 0x4401));
+		}
+
+		__device__ inline std::uint32_t device_bswap(std::uint32_t src)
+		{
+			return __byte_perm(src, 0, 0x0123);
+		}
+
+		__device__ inline std::uint64_t device_bswap(std::uint64_t src)
+		{
+			return static_cast<std::uint64_t>(device_bswap(static_cast<std::uint32_t>(src))) << 32 | device_bswap(static_cast<std::uint32_t>(src >> 32));
+		}
+#endif
+
 		// Optimization helper (B: storage type; Base: CRTP)
 		template <typename T, typename B, typename Base>
 		struct endian_buffer_opt
 		{
-			static inline void put_re(B& dst, const T& src)
+			static ENDIAN_CONSTEXPR void put_re(B& dst, const T& src)
+			{
+				dst = Base::swap(bit_cast<B>(src));
+			}
+
+			static ENDIAN_CONSTEXPR T get_re(const B& src)
+			{
+				return bit_cast<T>(Base::swap(src));
+			}
+
+			static ENDIAN_CONSTEXPR void put_ne(B& dst, const T& src)
+			{
+				dst = bit_cast<B>(src);
+			}
+
+			static ENDIAN_CONSTEXPR T get_ne(const B& src)
 			{
-				dst = Base::swap(reinterpret_cast<const B&>(src));
+				return bit_cast<T>(src);
 			}
 
-			static inline T get_re(const B& src)
+			// Load from unaligned memory with byteswap
+			static ENDIAN_CONSTEXPR T load_re(const uchar* src)
 			{
-				const B value = Base::swap(src);
-				return reinterpret_cast<const T&>(value);
+				byte_array<sizeof(B)> bytes{};
+				copy_bytes<sizeof(B)>(bytes.data, src);
+				return get_re(bit_cast<B>(bytes));
 			}
 
-			static inline void put_ne(B& dst, const T& src)
+			// Store to unaligned memory with byteswap
+			static ENDIAN_CONSTEXPR void store_re(uchar* dst, const T& src)
 			{
-				dst = reinterpret_cast<const B&>(src);
+				B value{};
+				put_re(value, src);
+				const auto bytes = bit_cast<byte_array<sizeof(B)>>(value);
+				copy_bytes<sizeof(B)>(dst, bytes.data);
 			}
 
-			static inline T get_ne(const B& src)
+			template <typename R>
+			static ENDIAN_CONSTEXPR R get_raw(const B& src)
 			{
-				return reinterpret_cast<const T&>(src);
+				return bit_cast<R>(src);
 			}
 
-			operator const B&() const
+			template <typename R>
+			static ENDIAN_CONSTEXPR void put_raw(B& dst, const R& src)
+			{
+				dst = bit_cast<B>(src);
+			}
+
+			ENDIAN_HOST_DEVICE constexpr operator const B&() const
 			{
 				return data;
 			}
 
-			operator B&()
+			ENDIAN_CONSTEXPR operator B&()
 			{
 				return data;
 			}
@@ -193,14 +574,38 @@ namespace std
 
 			using type = std::uint16_t;
 
-			static inline type swap(type src)
+			static ENDIAN_CONSTEXPR type swap(type src)
 			{
-#if defined(__GNUG__)
+#if defined(ENDIAN_DEVICE_CODE)
+				return ENDIAN_IS_CONSTEVAL() ? revert_int(src) : device_bswap(src);
+#elif defined(__GNUG__)
 				return __builtin_bswap16(src);
 #else
-				return _byteswap_ushort(src);
+				return ENDIAN_IS_CONSTEVAL() ? revert_int(src) : _byteswap_ushort(src);
 #endif
 			}
+
+#if defined(ENDIAN_MOVBE_ASM)
+			static ENDIAN_CONSTEXPR T load_re(const uchar* src)
+			{
+				if (ENDIAN_IS_CONSTEVAL())
+				{
+					return endian_buffer::endian_buffer_opt::load_re(src);
+				}
+
+				return bit_cast<T>(movbe_load<type>(src));
+			}
+
+			static ENDIAN_CONSTEXPR void store_re(uchar* dst, const T& src)
+			{
+				if (ENDIAN_IS_CONSTEVAL() || __builtin_constant_p(src))
+				{
+					return endian_buffer::endian_buffer_opt::store_re(dst, src);
+				}
+
+				movbe_store(dst, bit_cast<type>(src));
+			}
+#endif
 		};
 
 		// Optional optimization (may be removed)
@@ -211,14 +616,38 @@ namespace std
 
 			using type = std::uint32_t;
 
-			static inline type swap(type src)
+			static ENDIAN_CONSTEXPR type swap(type src)
 			{
-#if defined(__GNUG__)
+#if defined(ENDIAN_DEVICE_CODE)
+				return ENDIAN_IS_CONSTEVAL() ? revert_int(src) : device_bswap(src);
+#elif defined(__GNUG__)
 				return __builtin_bswap32(src);
 #else
-				return _byteswap_ulong(src);
+				return ENDIAN_IS_CONSTEVAL() ? revert_int(src) : _byteswap_ulong(src);
 #endif
 			}
+
+#if defined(ENDIAN_MOVBE_ASM)
+			static ENDIAN_CONSTEXPR T load_re(const uchar* src)
+			{
+				if (ENDIAN_IS_CONSTEVAL())
+				{
+					return endian_buffer::endian_buffer_opt::load_re(src);
+				}
+
+				return bit_cast<T>(movbe_load<type>(src));
+			}
+
+			static ENDIAN_CONSTEXPR void store_re(uchar* dst, const T& src)
+			{
+				if (ENDIAN_IS_CONSTEVAL() || __builtin_constant_p(src))
+				{
+					return endian_buffer::endian_buffer_opt::store_re(dst, src);
+				}
+
+				movbe_store(dst, bit_cast<type>(src));
+			}
+#endif
 		};
 
 		// Optional optimization (may be removed)
@@ -229,15 +658,81 @@ namespace std
 
 			using type = std::uint64_t;
 
-			static inline type swap(type src)
+			static ENDIAN_CONSTEXPR type swap(type src)
 			{
-#if defined(__GNUG__)
+#if defined(ENDIAN_DEVICE_CODE)
+				return ENDIAN_IS_CONSTEVAL() ? revert_int(src) : device_bswap(src);
+#elif defined(__GNUG__)
 				return __builtin_bswap64(src);
 #else
-				return _byteswap_uint64(src);
+				return ENDIAN_IS_CONSTEVAL() ? revert_int(src) : _byteswap_uint64(src);
+#endif
+			}
+
+#if defined(ENDIAN_MOVBE_ASM) && defined(__x86_64__)
+			static ENDIAN_CONSTEXPR T load_re(const uchar* src)
+			{
+				if (ENDIAN_IS_CONSTEVAL())
+				{
+					return endian_buffer::endian_buffer_opt::load_re(src);
+				}
+
+				return bit_cast<T>(movbe_load<type>(src));
+			}
+
+			static ENDIAN_CONSTEXPR void store_re(uchar* dst, const T& src)
+			{
+				if (ENDIAN_IS_CONSTEVAL() || __builtin_constant_p(src))
+				{
+					return endian_buffer::endian_buffer_opt::store_re(dst, src);
+				}
+
+				movbe_store(dst, bit_cast<type>(src));
+			}
+#endif
+		};
+
+#if defined(__SIZEOF_INT128__)
+		// Optional optimization (may be removed)
+		template <typename T>
+		struct endian_buffer<T, 16, 16> : endian_buffer_opt<T, uint128_t, endian_buffer<T, 16, 16>>
+		{
+			static_assert(alignof(uint128_t) == 16, "Unexpected unsigned __int128 alignment");
+
+			using type = uint128_t;
+
+			static ENDIAN_CONSTEXPR type swap(type src)
+			{
+#if defined(ENDIAN_DEVICE_CODE)
+				return static_cast<type>(endian_buffer<T, 8, 8>::swap(static_cast<std::uint64_t>(src))) << 64 | endian_buffer<T, 8, 8>::swap(static_cast<std::uint64_t>(src >> 64));
+#else
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bswap128)
+				return __builtin_bswap128(src);
+#endif
 #endif
+				return static_cast<type>(__builtin_bswap64(static_cast<std::uint64_t>(src))) << 64 | __builtin_bswap64(static_cast<std::uint64_t>(src >> 64));
+#endif
+			}
+		};
+#elif defined(_MSC_VER)
+		struct alignas(16) uint128_pair
+		{
+			std::uint64_t lo, hi;
+		};
+
+		// Optional optimization (may be removed)
+		template <typename T>
+		struct endian_buffer<T, 16, 16> : endian_buffer_opt<T, uint128_pair, endian_buffer<T, 16, 16>>
+		{
+			using type = uint128_pair;
+
+			static ENDIAN_CONSTEXPR type swap(type src)
+			{
+				return {endian_buffer<T, 8, 8>::swap(src.hi), endian_buffer<T, 8, 8>::swap(src.lo)};
 			}
 		};
+#endif
 #endif
 	}
 
@@ -254,7 +749,7 @@ namespace std
 #endif
 
 	template <typename T>
-	void le_store(void* dst, const T& value)
+	ENDIAN_HOST_DEVICE void le_store(void* dst, const T& value)
 	{
 		static_assert(has_endianness<T>::value, "le_store<>: invalid type");
 		using buf = detail::endian_buffer<T>;
@@ -262,7 +757,7 @@ namespace std
 	}
 
 	template <typename T>
-	void le_load(T& value, const void* src)
+	ENDIAN_HOST_DEVICE void le_load(T& value, const void* src)
 	{
 		static_assert(has_endianness<T>::value, "le_load<>: invalid type");
 		using buf = detail::endian_buffer<T>;
@@ -270,7 +765,7 @@ namespace std
 	}
 
 	template <typename T>
-	T le_load(const void* src)
+	ENDIAN_HOST_DEVICE T le_load(const void* src)
 	{
 		static_assert(has_endianness<T>::value, "le_load<>: invalid type");
 		using buf = detail::endian_buffer<T>;
@@ -278,7 +773,7 @@ namespace std
 	}
 
 	template <typename T>
-	void be_store(void* dst, const T& value)
+	ENDIAN_HOST_DEVICE void be_store(void* dst, const T& value)
 	{
 		static_assert(has_endianness<T>::value, "be_store<>: invalid type");
 		using buf = detail::endian_buffer<T>;
@@ -286,7 +781,7 @@ namespace std
 	}
 
 	template <typename T>
-	void be_load(T& value, const void* src)
+	ENDIAN_HOST_DEVICE void be_load(T& value, const void* src)
 	{
 		static_assert(has_endianness<T>::value, "be_load<>: invalid type");
 		using buf = detail::endian_buffer<T>;
@@ -294,7 +789,7 @@ namespace std
 	}
 
 	template <typename T>
-	T be_load(const void* src)
+	ENDIAN_HOST_DEVICE T be_load(const void* src)
 	{
 		static_assert(has_endianness<T>::value, "be_load<>: invalid type");
 		using buf = detail::endian_buffer<T>;
@@ -306,159 +801,4927 @@ namespace std
 #undef BE_STORE
 #undef BE_LOAD
 
-	// Endianness support type
-	template <typename T, std::size_t Align, bool Native>
-	class endian_base
+	// Store mode for bulk functions
+	enum class bulk_store
 	{
-		static_assert(has_endianness<T>::value, "endian_base<>: invalid type");
+		automatic, // streaming if size >= ENDIAN_STREAM_THRESHOLD
+		temporal,
+		streaming, // non-temporal stores (bypass cache), use when the result isn't needed soon
+	};
 
-		using buf = detail::endian_buffer<T, sizeof(T), Align>;
-		using data_t = typename buf::type;
+	namespace detail
+	{
+		// Bulk byteswap mask index (reverse bytes within each Size-byte element)
+		template <std::size_t Size>
+		constexpr uchar bswap_index(std::size_t i)
+		{
+			return static_cast<uchar>(i - i % Size + (Size - 1 - i % Size));
+		}
 
-		data_t data;
+		template <std::size_t Size, std::size_t... I>
+		inline const uchar* bswap_mask(std::index_sequence<I...>)
+		{
+			alignas(64) static const uchar mask[]{bswap_index<Size>(I)...};
+			return mask;
+		}
 
-	public:
-		using value_type = T;
+		// 64-byte mask for pshufb-like instructions
+		template <std::size_t Size>
+		inline const uchar* bswap_mask()
+		{
+			return bswap_mask<Size>(std::make_index_sequence<64>());
+		}
 
-		endian_base() = default;
+		using bswap_n_func = void (*)(uchar* dst, const uchar* src, std::size_t n);
 
-		endian_base(const T& value)
+		// Bulk byteswap (fallback algorithm)
+		template <std::size_t Size>
+		inline void bswap_n_revert(uchar* dst, const uchar* src, std::size_t n)
 		{
-			Native ? buf::put_ne(data, value) : buf::put_re(data, value);
+			for (std::size_t i = 0; i < n; i++, dst += Size, src += Size)
+			{
+				uchar buf[Size];
+				revert<Size>(buf, src);
+				std::memcpy(dst, buf, Size);
+			}
 		}
 
-		endian_base& operator=(const endian_base&) = default;
+		// Bulk byteswap with scalar instructions
+		template <std::size_t Size, typename R = typename uint_of_size<Size>::type>
+		struct bswap_n_scalar
+		{
+			static ENDIAN_FORCEINLINE void run(uchar* dst, const uchar* src, std::size_t n)
+			{
+				using buf = endian_buffer<R, Size, 1>;
+
+				for (std::size_t i = 0; i < n; i++, dst += Size, src += Size)
+				{
+					buf::put_ne(*reinterpret_cast<buf*>(dst), buf::get_re(*reinterpret_cast<const buf*>(src)));
+				}
+			}
+		};
 
-		endian_base& operator=(const T& value)
+		template <std::size_t Size>
+		struct bswap_n_scalar<Size, void>
 		{
-			Native ? buf::put_ne(data, value) : buf::put_re(data, value);
-			return *this;
+			static ENDIAN_FORCEINLINE void run(uchar* dst, const uchar* src, std::size_t n)
+			{
+				bswap_n_revert<Size>(dst, src, n);
+			}
+		};
+
+		// Bulk byteswap (scalar, also used for tails)
+		template <std::size_t Size>
+		ENDIAN_FORCEINLINE void bswap_n_generic(uchar* dst, const uchar* src, std::size_t n)
+		{
+			bswap_n_scalar<Size>::run(dst, src, n);
 		}
 
-		operator T() const
+#if defined(ENDIAN_X86)
+		// Process head until dst is aligned for non-temporal stores (dst must be aligned to Size)
+		template <std::size_t Size, std::size_t Align>
+		inline std::size_t stream_head(uchar* dst, const uchar* src, std::size_t n)
 		{
-			return Native ? buf::get_ne(data) : buf::get_re(data);
+			const std::size_t head = (Align - reinterpret_cast<std::uintptr_t>(dst) % Align) % Align / Size;
+			const std::size_t count = head < n ? head : n;
+			bswap_n_generic<Size>(dst, src, count);
+			return count * Size;
 		}
 
-		T get() const
+		template <std::size_t Size, bool Stream = false>
+		ENDIAN_TARGET("ssse3") inline void bswap_n_ssse3(uchar* dst, const uchar* src, std::size_t n)
 		{
-			return Native ? buf::get_ne(data) : buf::get_re(data);
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(bswap_mask<Size>()));
+
+			std::size_t i = Stream ? stream_head<Size, 16>(dst, src, n) : 0;
+
+			for (const std::size_t bytes = n * Size; i + 16 <= bytes; i += 16)
+			{
+				if (Stream && i + ENDIAN_PREFETCH_DISTANCE < bytes)
+					_mm_prefetch(reinterpret_cast<const char*>(src + i + ENDIAN_PREFETCH_DISTANCE), _MM_HINT_NTA);
+
+				const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), mask);
+				Stream ? _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), v) : _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+			}
+
+			bswap_n_generic<Size>(dst + i, src + i, n - i / Size);
 		}
 
-		auto operator++(int)
+		template <std::size_t Size, bool Stream = false>
+		ENDIAN_TARGET("avx2") inline void bswap_n_avx2(uchar* dst, const uchar* src, std::size_t n)
 		{
-			auto val = get();
-			auto result = val++;
-			*this = val;
-			return result; // Forward
+			const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(bswap_mask<Size>()));
+
+			std::size_t i = Stream ? stream_head<Size, 32>(dst, src, n) : 0;
+
+			for (const std::size_t bytes = n * Size; i + 64 <= bytes; i += 64)
+			{
+				if (Stream && i + ENDIAN_PREFETCH_DISTANCE < bytes)
+					_mm_prefetch(reinterpret_cast<const char*>(src + i + ENDIAN_PREFETCH_DISTANCE), _MM_HINT_NTA);
+
+				const __m256i v0 = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), mask);
+				const __m256i v1 = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32)), mask);
+				Stream ? _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v0) : _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v0);
+				Stream ? _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 32), v1) : _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 32), v1);
+			}
+
+			bswap_n_ssse3<Size, Stream>(dst + i, src + i, n - i / Size);
 		}
 
-		auto operator--(int)
+		template <std::size_t Size, bool Stream = false>
+		ENDIAN_TARGET("avx512f,avx512bw") inline void bswap_n_avx512(uchar* dst, const uchar* src, std::size_t n)
 		{
-			auto val = get();
-			auto result = val--;
-			*this = val;
-			return result; // Forward
+			const __m512i mask = _mm512_load_si512(bswap_mask<Size>());
+
+			std::size_t i = Stream ? stream_head<Size, 64>(dst, src, n) : 0;
+
+			for (const std::size_t bytes = n * Size; i + 128 <= bytes; i += 128)
+			{
+				if (Stream && i + ENDIAN_PREFETCH_DISTANCE < bytes)
+				{
+					_mm_prefetch(reinterpret_cast<const char*>(src + i + ENDIAN_PREFETCH_DISTANCE), _MM_HINT_NTA);
+					_mm_prefetch(reinterpret_cast<const char*>(src + i + ENDIAN_PREFETCH_DISTANCE + 64), _MM_HINT_NTA);
+				}
+
+				const __m512i v0 = _mm512_shuffle_epi8(_mm512_loadu_si512(src + i), mask);
+				const __m512i v1 = _mm512_shuffle_epi8(_mm512_loadu_si512(src + i + 64), mask);
+				Stream ? _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i), v0) : _mm512_storeu_si512(dst + i, v0);
+				Stream ? _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + i + 64), v1) : _mm512_storeu_si512(dst + i + 64, v1);
+			}
+
+			bswap_n_ssse3<Size, Stream>(dst + i, src + i, n - i / Size);
 		}
 
-		endian_base& operator++()
+		ENDIAN_TARGET("sse") inline void store_fence()
 		{
-			auto val = get();
-			++val;
-			return (*this = val);
+			_mm_sfence();
+		}
+#elif defined(ENDIAN_NEON)
+		template <std::size_t Size>
+		inline void bswap_n_neon(uchar* dst, const uchar* src, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (const std::size_t bytes = n * Size; i + 16 <= bytes; i += 16)
+			{
+				const uint8x16_t v = vld1q_u8(src + i);
+				const uint8x16_t r = Size == 2 ? vrev16q_u8(v) : Size == 4 ? vrev32q_u8(v) : vrev64q_u8(v);
+				vst1q_u8(dst + i, Size == 16 ? vextq_u8(r, r, 8) : r);
+			}
+
+			bswap_n_generic<Size>(dst + i, src + i, n - i / Size);
 		}
+#endif
 
-		endian_base& operator--()
+		// Select best bulk byteswap implementation for current CPU (Stream: use non-temporal stores)
+		template <std::size_t Size, bool Stream = false>
+		inline bswap_n_func select_bswap_n()
 		{
-			auto val = get();
-			--val;
-			return (*this = val);
+			if (Size != 2 && Size != 4 && Size != 8 && Size != 16)
+			{
+				return bswap_n_generic<Size>;
+			}
+
+#if defined(ENDIAN_X86_DISPATCH)
+			__builtin_cpu_init();
+
+			if (__builtin_cpu_supports("avx512bw"))
+				return bswap_n_avx512<Size, Stream>;
+			if (__builtin_cpu_supports("avx2"))
+				return bswap_n_avx2<Size, Stream>;
+			if (__builtin_cpu_supports("ssse3"))
+				return bswap_n_ssse3<Size, Stream>;
+#elif defined(ENDIAN_X86) && defined(__AVX512BW__)
+			return bswap_n_avx512<Size, Stream>;
+#elif defined(ENDIAN_X86) && defined(__AVX2__)
+			return bswap_n_avx2<Size, Stream>;
+#elif defined(ENDIAN_X86) && (defined(__SSSE3__) || defined(__AVX__))
+			return bswap_n_ssse3<Size, Stream>;
+#elif defined(ENDIAN_NEON)
+			return bswap_n_neon<Size>;
+#endif
+			return bswap_n_generic<Size>;
 		}
 
-		template <typename T2>
-		endian_base& operator+=(T2&& rhs)
+		// Copy n elements of given size without byteswap (dst == src is allowed)
+		template <std::size_t Size>
+		inline void copy_n_ne(void* dst, const void* src, std::size_t n, bulk_store = bulk_store::automatic)
 		{
-			auto val = get();
-			val += std::forward<T2>(rhs);
-			return (*this = val);
+			if (dst != src)
+			{
+				std::memcpy(dst, src, n * Size);
+			}
 		}
 
-		template <typename T2>
-		endian_base& operator-=(T2&& rhs)
+		// Copy n elements of given size with byteswap (dst == src is allowed)
+		template <std::size_t Size>
+		inline void copy_n_re(void* dst, const void* src, std::size_t n, bulk_store mode = bulk_store::automatic)
 		{
-			auto val = get();
-			val -= std::forward<T2>(rhs);
-			return (*this = val);
+			if (Size == 1)
+			{
+				copy_n_ne<Size>(dst, src, n);
+				return;
+			}
+
+#if defined(ENDIAN_X86)
+			if (mode == bulk_store::streaming || (mode == bulk_store::automatic && n * Size >= ENDIAN_STREAM_THRESHOLD))
+			{
+				// Only possible if element boundaries can be aligned to the vector size
+				if (reinterpret_cast<std::uintptr_t>(dst) % Size == 0)
+				{
+					static const bswap_n_func func = select_bswap_n<Size, true>();
+					func(static_cast<uchar*>(dst), static_cast<const uchar*>(src), n);
+					store_fence();
+					return;
+				}
+			}
+#else
+			static_cast<void>(mode);
+#endif
+
+			static const bswap_n_func func = select_bswap_n<Size>();
+			func(static_cast<uchar*>(dst), static_cast<const uchar*>(src), n);
 		}
+	}
 
-		template <typename T2>
-		endian_base& operator*=(T2&& rhs)
+#ifdef __BIG_ENDIAN__
+#define LE_COPY_N copy_n_re
+#define BE_COPY_N copy_n_ne
+#else
+#define LE_COPY_N copy_n_ne
+#define BE_COPY_N copy_n_re
+#endif
+
+	// Load n little endian values from src (arrays must not overlap, unless dst == src)
+	template <typename T>
+	void le_copy_n(T* dst, const void* src, std::size_t n, bulk_store mode = bulk_store::automatic)
+	{
+		static_assert(has_endianness<T>::value, "le_copy_n<>: invalid type");
+		detail::LE_COPY_N<sizeof(T)>(dst, src, n, mode);
+	}
+
+	// Store n values to dst as little endian (arrays must not overlap, unless dst == src)
+	template <typename T>
+	void le_store_n(void* dst, const T* src, std::size_t n, bulk_store mode = bulk_store::automatic)
+	{
+		static_assert(has_endianness<T>::value, "le_store_n<>: invalid type");
+		detail::LE_COPY_N<sizeof(T)>(dst, src, n, mode);
+	}
+
+	// Load n big endian values from src (arrays must not overlap, unless dst == src)
+	template <typename T>
+	void be_copy_n(T* dst, const void* src, std::size_t n, bulk_store mode = bulk_store::automatic)
+	{
+		static_assert(has_endianness<T>::value, "be_copy_n<>: invalid type");
+		detail::BE_COPY_N<sizeof(T)>(dst, src, n, mode);
+	}
+
+	// Store n values to dst as big endian (arrays must not overlap, unless dst == src)
+	template <typename T>
+	void be_store_n(void* dst, const T* src, std::size_t n, bulk_store mode = bulk_store::automatic)
+	{
+		static_assert(has_endianness<T>::value, "be_store_n<>: invalid type");
+		detail::BE_COPY_N<sizeof(T)>(dst, src, n, mode);
+	}
+
+#undef LE_COPY_N
+#undef BE_COPY_N
+
+	// Sequential reader of LE/BE data (Checked = false: no bounds checking)
+	template <endian Order, bool Checked = true>
+	class endian_reader
+	{
+		template <endian, bool>
+		friend class endian_reader;
+
+		const unsigned char* ptr = nullptr;
+		const unsigned char* end_ptr = nullptr;
+		bool failed = false;
+
+		// Unchecked cursor still tests `failed` (set by failed reserve) so it doesn't access null pointer
+		bool check(std::size_t n, std::size_t size)
 		{
-			auto val = get();
-			val *= std::forward<T2>(rhs);
-			return (*this = val);
+			if (failed || (Checked && static_cast<std::size_t>(end_ptr - ptr) / size < n))
+			{
+				failed = true;
+				return false;
+			}
+
+			return true;
 		}
 
-		template <typename T2>
-		endian_base& operator/=(T2&& rhs)
+	public:
+		endian_reader() = default;
+
+		endian_reader(const void* data, std::size_t size)
+		    : ptr(static_cast<const unsigned char*>(data))
+		    , end_ptr(ptr + size)
 		{
-			auto val = get();
-			val /= std::forward<T2>(rhs);
-			return (*this = val);
 		}
 
-		template <typename T2>
-		endian_base& operator%=(T2&& rhs)
+		// False if any checked operation failed (reading stops at this point)
+		explicit operator bool() const
 		{
-			auto val = get();
-			val %= std::forward<T2>(rhs);
-			return (*this = val);
+			return !failed;
 		}
 
-		template <typename T2>
-		endian_base& operator&=(T2&& rhs)
+		const void* data() const
 		{
-			auto val = get();
-			val &= std::forward<T2>(rhs);
-			return (*this = val);
+			return ptr;
 		}
 
-		template <typename T2>
-		endian_base& operator|=(T2&& rhs)
+		// Remaining size
+		std::size_t size() const
 		{
-			auto val = get();
-			val |= std::forward<T2>(rhs);
-			return (*this = val);
+			return end_ptr - ptr;
 		}
 
-		template <typename T2>
-		endian_base& operator^=(T2&& rhs)
+		// Read single value (value-initialized on failure)
+		template <typename T>
+		T read()
 		{
-			auto val = get();
-			val ^= std::forward<T2>(rhs);
-			return (*this = val);
+			static_assert(has_endianness<T>::value, "endian_reader<>::read: invalid type");
+
+			if (!check(1, sizeof(T)))
+			{
+				return T{};
+			}
+
+			const T value = Order == endian::big ? be_load<T>(ptr) : le_load<T>(ptr);
+			ptr += sizeof(T);
+			return value;
 		}
 
-		template <typename T2>
-		endian_base& operator<<=(T2&& rhs)
+		template <typename T>
+		bool read(T& value)
 		{
-			auto val = get();
-			val <<= std::forward<T2>(rhs);
-			return (*this = val);
+			value = read<T>();
+			return !failed;
 		}
 
-		template <typename T2>
-		endian_base& operator>>=(T2&& rhs)
+		// Read array (bulk conversion)
+		template <typename T>
+		bool read_n(T* dst, std::size_t n)
 		{
-			auto val = get();
-			val >>= std::forward<T2>(rhs);
-			return (*this = val);
+			static_assert(has_endianness<T>::value, "endian_reader<>::read_n: invalid type");
+
+			if (!check(n, sizeof(T)))
+			{
+				return false;
+			}
+
+			Order == endian::big ? be_copy_n(dst, ptr, n) : le_copy_n(dst, ptr, n);
+			ptr += n * sizeof(T);
+			return true;
+		}
+
+		bool skip(std::size_t bytes)
+		{
+			if (!check(bytes, 1))
+			{
+				return false;
+			}
+
+			ptr += bytes;
+			return true;
+		}
+
+		// Check bounds once and return unchecked reader for the next bytes (on failure it's false and reads nothing)
+		endian_reader<Order, false> reserve(std::size_t bytes)
+		{
+			endian_reader<Order, false> result;
+
+			if (!check(bytes, 1))
+			{
+				result.failed = true;
+				return result;
+			}
+
+			result.ptr = ptr;
+			result.end_ptr = ptr += bytes;
+			return result;
 		}
 	};
 
-	template <typename T, std::size_t A = alignof(T)>
-	using le_t = endian_base<T, A, endian::native == endian::little>;
+	// Sequential writer of LE/BE data (Checked = false: no bounds checking)
+	template <endian Order, bool Checked = true>
+	class endian_writer
+	{
+		template <endian, bool>
+		friend class endian_writer;
 
-	template <typename T, std::size_t A = alignof(T)>
-	using be_t = endian_base<T, A, endian::native == endian::big>;
+		unsigned char* ptr = nullptr;
+		unsigned char* end_ptr = nullptr;
+		bool failed = false;
+
+		// Unchecked cursor still tests `failed` (set by failed reserve) so it doesn't access null pointer
+		bool check(std::size_t n, std::size_t size)
+		{
+			if (failed || (Checked && static_cast<std::size_t>(end_ptr - ptr) / size < n))
+			{
+				failed = true;
+				return false;
+			}
+
+			return true;
+		}
+
+	public:
+		endian_writer() = default;
+
+		endian_writer(void* data, std::size_t size)
+		    : ptr(static_cast<unsigned char*>(data))
+		    , end_ptr(ptr + size)
+		{
+		}
+
+		// False if any checked operation failed (writing stops at this point)
+		explicit operator bool() const
+		{
+			return !failed;
+		}
+
+		void* data() const
+		{
+			return ptr;
+		}
+
+		// Remaining size
+		std::size_t size() const
+		{
+			return end_ptr - ptr;
+		}
+
+		template <typename T>
+		bool write(const T& value)
+		{
+			static_assert(has_endianness<T>::value, "endian_writer<>::write: invalid type");
+
+			if (!check(1, sizeof(T)))
+			{
+				return false;
+			}
+
+			Order == endian::big ? be_store(ptr, value) : le_store(ptr, value);
+			ptr += sizeof(T);
+			return true;
+		}
+
+		// Write array (bulk conversion)
+		template <typename T>
+		bool write_n(const T* src, std::size_t n)
+		{
+			static_assert(has_endianness<T>::value, "endian_writer<>::write_n: invalid type");
+
+			if (!check(n, sizeof(T)))
+			{
+				return false;
+			}
+
+			Order == endian::big ? be_store_n(ptr, src, n) : le_store_n(ptr, src, n);
+			ptr += n * sizeof(T);
+			return true;
+		}
+
+		// Skip bytes (leaves them unmodified)
+		bool skip(std::size_t bytes)
+		{
+			if (!check(bytes, 1))
+			{
+				return false;
+			}
+
+			ptr += bytes;
+			return true;
+		}
+
+		// Check bounds once and return unchecked writer for the next bytes (on failure it's false and writes nothing)
+		endian_writer<Order, false> reserve(std::size_t bytes)
+		{
+			endian_writer<Order, false> result;
+
+			if (!check(bytes, 1))
+			{
+				result.failed = true;
+				return result;
+			}
+
+			result.ptr = ptr;
+			result.end_ptr = ptr += bytes;
+			return result;
+		}
+	};
+
+	using le_reader = endian_reader<endian::little>;
+	using be_reader = endian_reader<endian::big>;
+	using le_writer = endian_writer<endian::little>;
+	using be_writer = endian_writer<endian::big>;
+
+#if defined(ENDIAN_COUNTERS)
+	enum class endian_op
+	{
+		get, // get_re (load with byteswap)
+		put, // put_re (store with byteswap)
+		trampoline, // get_re/put_re through aligned temporary (Align != sizeof(T))
+	};
+
+	// Counter snapshot (file is nullptr for per-type totals)
+	struct endian_counter
+	{
+		const char* type;
+		std::size_t size;
+		std::size_t align;
+		endian_op op;
+		const char* file;
+		unsigned line;
+		unsigned column;
+		const char* function;
+		std::uint64_t count;
+	};
+
+#if defined(__cpp_lib_source_location)
+	using endian_location = std::source_location;
+#else
+	// Fallback for std::source_location (GCC/Clang/MSVC builtins)
+	struct endian_location
+	{
+		const char* m_file = "";
+		const char* m_function = "";
+		unsigned m_line = 0;
+
+		static constexpr endian_location current(const char* file = __builtin_FILE(), const char* function = __builtin_FUNCTION(), unsigned line = __builtin_LINE()) noexcept
+		{
+			return {file, function, line};
+		}
+
+		constexpr const char* file_name() const noexcept
+		{
+			return m_file;
+		}
+
+		constexpr const char* function_name() const noexcept
+		{
+			return m_function;
+		}
+
+		constexpr unsigned line() const noexcept
+		{
+			return m_line;
+		}
+
+		constexpr unsigned column() const noexcept
+		{
+			return 0;
+		}
+	};
+#endif
+
+	namespace detail
+	{
+		struct counter_node
+		{
+			std::string type;
+			std::size_t size;
+			std::size_t align;
+			endian_op op;
+			const char* file;
+			unsigned line;
+			unsigned column;
+			const char* function;
+			std::atomic<std::uint64_t> count{0};
+		};
+
+		struct counter_registry
+		{
+			// (type counter, file, line, column) -> counter; nodes are never freed
+			std::map<std::tuple<const counter_node*, const char*, unsigned, unsigned>, counter_node*> nodes;
+			std::mutex mutex;
+			void (*callback)(const endian_counter&) = nullptr;
+			bool at_exit = true;
+
+			static counter_registry& get()
+			{
+				static counter_registry registry;
+				return registry;
+			}
+
+			// Sorted by count (descending)
+			std::vector<endian_counter> snapshot()
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				std::vector<endian_counter> result;
+
+				for (auto& pair : nodes)
+				{
+					const counter_node& node = *pair.second;
+					result.push_back({node.type.c_str(), node.size, node.align, node.op, node.file, node.line, node.column, node.function, node.count.load(std::memory_order_relaxed)});
+				}
+
+				std::stable_sort(result.begin(), result.end(), [](const endian_counter& a, const endian_counter& b) { return a.count > b.count; });
+				return result;
+			}
+
+			counter_node* find(const counter_node* parent, const char* type, std::size_t size, std::size_t align, endian_op op, const endian_location* loc)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				const auto key = loc ? std::make_tuple(parent, loc->file_name(), static_cast<unsigned>(loc->line()), static_cast<unsigned>(loc->column())) : std::make_tuple(parent, type, static_cast<unsigned>(align), static_cast<unsigned>(op));
+				auto& node = nodes[key];
+
+				if (!node)
+				{
+					node = new counter_node{type_name(type), size, align, op, loc ? loc->file_name() : nullptr, loc ? static_cast<unsigned>(loc->line()) : 0, loc ? static_cast<unsigned>(loc->column()) : 0, loc ? loc->function_name() : nullptr};
+				}
+
+				return node;
+			}
+
+			~counter_registry();
+
+		private:
+			// Extract T from function signature of counter_type<T>()
+			static std::string type_name(const char* sig)
+			{
+				std::string s = sig;
+				std::size_t begin = s.find("T = ");
+
+				if (begin != std::string::npos)
+				{
+					begin += 4;
+					return s.substr(begin, s.find_first_of(";]", begin) - begin);
+				}
+
+				begin = s.find("counter_type<");
+
+				if (begin != std::string::npos)
+				{
+					begin += 13;
+					return s.substr(begin, s.rfind(">(") - begin);
+				}
+
+				return s;
+			}
+		};
+
+		template <typename T>
+		const char* counter_type()
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			return __FUNCSIG__;
+#else
+			return __PRETTY_FUNCTION__;
+#endif
+		}
+
+		// Per type/size/alignment counter
+		template <typename T, std::size_t Align, endian_op Op>
+		counter_node& type_counter()
+		{
+			static counter_node& node = *counter_registry::get().find(nullptr, counter_type<T>(), sizeof(T), Align, Op, nullptr);
+			return node;
+		}
+
+		// Per call site counter (cached in thread-local map)
+		template <typename T, std::size_t Align, endian_op Op>
+		counter_node& site_counter(const endian_location& loc)
+		{
+			static thread_local std::map<std::tuple<const char*, unsigned, unsigned>, counter_node*> cache;
+			auto& node = cache[std::make_tuple(loc.file_name(), static_cast<unsigned>(loc.line()), static_cast<unsigned>(loc.column()))];
+
+			if (!node)
+			{
+				node = counter_registry::get().find(&type_counter<T, Align, Op>(), counter_type<T>(), sizeof(T), Align, Op, &loc);
+			}
+
+			return *node;
+		}
+
+		template <typename T, std::size_t Align, bool Native, endian_op Op>
+		ENDIAN_CONSTEXPR void count_conversion(const endian_location* loc = nullptr)
+		{
+			if (Native || ENDIAN_IS_CONSTEVAL())
+			{
+				return;
+			}
+
+			type_counter<T, Align, Op>().count.fetch_add(1, std::memory_order_relaxed);
+
+			// Same condition as endian_buffer<>::can_opt
+			if ((sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 || sizeof(T) == 16) && Align != sizeof(T))
+			{
+				type_counter<T, Align, endian_op::trampoline>().count.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			if (loc)
+			{
+				site_counter<T, Align, Op>(*loc).count.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Call func(const endian_counter&) for every counter, sorted by count
+	template <typename F>
+	void endian_counters_report(F&& func)
+	{
+		for (const endian_counter& counter : detail::counter_registry::get().snapshot())
+		{
+			func(counter);
+		}
+	}
+
+	// Print counters
+	inline void endian_counters_dump(std::FILE* out = stderr)
+	{
+		static const char* const ops[]{"get", "put", "tramp"};
+
+		std::fprintf(out, "endian.hpp conversion counters:\n");
+
+		endian_counters_report([&](const endian_counter& c) {
+			if (c.file)
+			{
+				std::fprintf(out, "%14llu %-5s %s (size %zu, align %zu) at %s:%u:%u (%s)\n", static_cast<unsigned long long>(c.count), ops[static_cast<int>(c.op)], c.type, c.size, c.align, c.file, c.line, c.column, c.function);
+			}
+			else
+			{
+				std::fprintf(out, "%14llu %-5s %s (size %zu, align %zu) total\n", static_cast<unsigned long long>(c.count), ops[static_cast<int>(c.op)], c.type, c.size, c.align);
+			}
+		});
+	}
+
+	// Report at exit: call callback for every counter (nullptr: dump to stderr), enable = false disables report
+	inline void endian_counters_at_exit(void (*callback)(const endian_counter&), bool enable = true)
+	{
+		auto& registry = detail::counter_registry::get();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.callback = callback;
+		registry.at_exit = enable;
+	}
+
+	inline detail::counter_registry::~counter_registry()
+	{
+		if (!at_exit)
+		{
+			return;
+		}
+
+		if (callback)
+		{
+			endian_counters_report(callback);
+		}
+		else
+		{
+			endian_counters_dump(stderr);
+		}
+	}
+
+// Default argument capturing call site of get() and constructor
+#define ENDIAN_LOCATION_PARAM const endian_location& loc = endian_location::current()
+#define ENDIAN_LOCATION_ARG , ENDIAN_LOCATION_PARAM
+#define ENDIAN_COUNT(op) detail::count_conversion<T, Align, Native, endian_op::op>()
+#define ENDIAN_COUNT_AT(op) detail::count_conversion<T, Align, Native, endian_op::op>(&loc)
+#else
+#define ENDIAN_LOCATION_PARAM
+#define ENDIAN_LOCATION_ARG
+#define ENDIAN_COUNT(op) static_cast<void>(0)
+#define ENDIAN_COUNT_AT(op) static_cast<void>(0)
+#endif
+
+	// Endianness support type
+	template <typename T, std::size_t Align, bool Native>
+	class endian_base
+	{
+		static_assert(has_endianness<T>::value, "endian_base<>: invalid type");
+
+		using buf = detail::endian_buffer<T, sizeof(T), Align>;
+		using data_t = typename buf::type;
+
+		data_t data;
+
+		template <typename, std::size_t, bool>
+		friend class endian_base;
+
+		// Storage as unsigned integer (void if not available)
+		using raw_t = typename detail::uint_of_size<sizeof(T)>::type;
+
+		// Bitwise ops and comparisons which can be performed on storage directly
+		static constexpr bool raw_bitwise = detail::is_integer<T>::value && !std::is_same<T, bool>::value && !std::is_void<raw_t>::value;
+		static constexpr bool raw_compare = (detail::is_integer<T>::value || std::is_enum<T>::value) && !std::is_void<raw_t>::value;
+
+		template <typename T2>
+		struct is_same_order : std::false_type
+		{
+		};
+
+		template <std::size_t A2>
+		struct is_same_order<endian_base<T, A2, Native>> : std::true_type
+		{
+		};
+
+		template <typename T2, typename D = std::decay_t<T2>>
+		using raw_bitwise_tag = std::integral_constant<bool, raw_bitwise && (detail::is_integer<D>::value || is_same_order<D>::value)>;
+
+		// 0: compare values, 1: compare storage, 2: compare storage if rhs is representable as T
+		template <typename T2>
+		using raw_compare_tag = std::integral_constant<int, !raw_compare ? 0 : std::is_same<T2, T>::value ? 1 : detail::is_integer<T>::value && detail::is_integer<T2>::value ? 2 : 0>;
+
+		ENDIAN_CONSTEXPR raw_t raw() const
+		{
+			return buf::template get_raw<raw_t>(data);
+		}
+
+		template <typename R>
+		ENDIAN_CONSTEXPR void raw(const R& value)
+		{
+			buf::put_raw(data, value);
+		}
+
+		// Convert operand to storage representation
+		template <std::size_t A2>
+		static ENDIAN_CONSTEXPR raw_t raw_operand(const endian_base<T, A2, Native>& rhs)
+		{
+			return rhs.raw();
+		}
+
+		template <typename T2>
+		static ENDIAN_CONSTEXPR raw_t raw_operand(const T2& rhs)
+		{
+			return endian_base(static_cast<T>(rhs)).raw();
+		}
+
+		template <typename Op, typename T2>
+		ENDIAN_CONSTEXPR endian_base& bitwise(const T2& rhs, std::true_type)
+		{
+			raw_t value = raw();
+			Op::apply(value, raw_operand(rhs));
+			raw(value);
+			return *this;
+		}
+
+		template <typename Op, typename T2>
+		ENDIAN_CONSTEXPR endian_base& bitwise(T2&& rhs, std::false_type)
+		{
+			auto val = get();
+			Op::apply(val, std::forward<T2>(rhs));
+			return (*this = val);
+		}
+
+		ENDIAN_CONSTEXPR bool test(const T& mask, std::true_type) const
+		{
+			return (raw() & raw_operand(mask)) != 0;
+		}
+
+		ENDIAN_CONSTEXPR bool test(const T& mask, std::false_type) const
+		{
+			return (get() & mask) != 0;
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR bool equals(const T2& rhs, std::integral_constant<int, 0>) const
+		{
+			return get() == rhs;
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR bool equals(const T2& rhs, std::integral_constant<int, 1>) const
+		{
+			return raw() == raw_operand(rhs);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR bool equals(const T2& rhs, std::integral_constant<int, 2>) const
+		{
+			using common_t = decltype(T() + T2());
+			return static_cast<common_t>(static_cast<T>(rhs)) == static_cast<common_t>(rhs) && raw() == raw_operand(rhs);
+		}
+
+	public:
+		using value_type = T;
+
+		endian_base() = default;
+
+		ENDIAN_CONSTEXPR endian_base(const T& value ENDIAN_LOCATION_ARG)
+		    : data{}
+		{
+			ENDIAN_COUNT_AT(put);
+			Native ? buf::put_ne(data, value) : buf::put_re(data, value);
+		}
+
+		endian_base& operator=(const endian_base&) = default;
+
+		ENDIAN_CONSTEXPR endian_base& operator=(const T& value)
+		{
+			ENDIAN_COUNT(put);
+			Native ? buf::put_ne(data, value) : buf::put_re(data, value);
+			return *this;
+		}
+
+		ENDIAN_CONSTEXPR operator T() const
+		{
+			ENDIAN_COUNT(get);
+			return Native ? buf::get_ne(data) : buf::get_re(data);
+		}
+
+		// Call site is recorded by ENDIAN_COUNTERS (implicit conversions are only counted per type)
+		ENDIAN_CONSTEXPR T get(ENDIAN_LOCATION_PARAM) const
+		{
+			ENDIAN_COUNT_AT(get);
+			return Native ? buf::get_ne(data) : buf::get_re(data);
+		}
+
+		// Test whether any of the mask bits are set (swaps the mask instead of the value)
+		ENDIAN_CONSTEXPR bool test(const T& mask) const
+		{
+			return test(mask, std::integral_constant<bool, raw_bitwise>());
+		}
+
+		// Comparisons (performed on storage when possible)
+		template <std::size_t A2>
+		friend ENDIAN_CONSTEXPR bool operator==(const endian_base& lhs, const endian_base<T, A2, Native>& rhs)
+		{
+			return lhs.equals(rhs, std::integral_constant<int, raw_compare ? 1 : 0>());
+		}
+
+		template <std::size_t A2>
+		friend ENDIAN_CONSTEXPR bool operator!=(const endian_base& lhs, const endian_base<T, A2, Native>& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		template <typename T2>
+		friend ENDIAN_CONSTEXPR std::enable_if_t<has_endianness<T2>::value, bool> operator==(const endian_base& lhs, const T2& rhs)
+		{
+			return lhs.equals(rhs, raw_compare_tag<T2>());
+		}
+
+		template <typename T2>
+		friend ENDIAN_CONSTEXPR std::enable_if_t<has_endianness<T2>::value, bool> operator==(const T2& lhs, const endian_base& rhs)
+		{
+			return rhs.equals(lhs, raw_compare_tag<T2>());
+		}
+
+		template <typename T2>
+		friend ENDIAN_CONSTEXPR std::enable_if_t<has_endianness<T2>::value, bool> operator!=(const endian_base& lhs, const T2& rhs)
+		{
+			return !lhs.equals(rhs, raw_compare_tag<T2>());
+		}
+
+		template <typename T2>
+		friend ENDIAN_CONSTEXPR std::enable_if_t<has_endianness<T2>::value, bool> operator!=(const T2& lhs, const endian_base& rhs)
+		{
+			return !rhs.equals(lhs, raw_compare_tag<T2>());
+		}
+
+		ENDIAN_CONSTEXPR auto operator++(int)
+		{
+			auto val = get();
+			auto result = val++;
+			*this = val;
+			return result; // Forward
+		}
+
+		ENDIAN_CONSTEXPR auto operator--(int)
+		{
+			auto val = get();
+			auto result = val--;
+			*this = val;
+			return result; // Forward
+		}
+
+		ENDIAN_CONSTEXPR endian_base& operator++()
+		{
+			auto val = get();
+			++val;
+			return (*this = val);
+		}
+
+		ENDIAN_CONSTEXPR endian_base& operator--()
+		{
+			auto val = get();
+			--val;
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_base& operator+=(T2&& rhs)
+		{
+			auto val = get();
+			val += std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_base& operator-=(T2&& rhs)
+		{
+			auto val = get();
+			val -= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_base& operator*=(T2&& rhs)
+		{
+			auto val = get();
+			val *= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_base& operator/=(T2&& rhs)
+		{
+			auto val = get();
+			val /= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_base& operator%=(T2&& rhs)
+		{
+			auto val = get();
+			val %= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_base& operator&=(T2&& rhs)
+		{
+			return bitwise<detail::op_and>(std::forward<T2>(rhs), raw_bitwise_tag<T2>());
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_base& operator|=(T2&& rhs)
+		{
+			return bitwise<detail::op_or>(std::forward<T2>(rhs), raw_bitwise_tag<T2>());
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_base& operator^=(T2&& rhs)
+		{
+			return bitwise<detail::op_xor>(std::forward<T2>(rhs), raw_bitwise_tag<T2>());
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_base& operator<<=(T2&& rhs)
+		{
+			auto val = get();
+			val <<= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_base& operator>>=(T2&& rhs)
+		{
+			auto val = get();
+			val >>= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+	};
+
+#undef ENDIAN_LOCATION_PARAM
+#undef ENDIAN_LOCATION_ARG
+#undef ENDIAN_COUNT
+#undef ENDIAN_COUNT_AT
+
+	template <typename T, std::size_t A = alignof(T)>
+	using le_t = endian_base<T, A, endian::native == endian::little>;
+
+	template <typename T, std::size_t A = alignof(T)>
+	using be_t = endian_base<T, A, endian::native == endian::big>;
+
+	// Atomic endianness support type (lock-free if std::atomic of the same size is)
+	template <typename T, bool Native>
+	class atomic_endian_base
+	{
+		static_assert(has_endianness<T>::value, "atomic_endian_base<>: invalid type");
+
+		using base_t = endian_base<T, sizeof(T), Native>;
+		using raw_t = typename detail::uint_of_size<sizeof(T)>::type;
+
+		static_assert(!std::is_void<raw_t>::value, "atomic_endian_base<>: unsupported size");
+
+		std::atomic<raw_t> data;
+
+		static ENDIAN_CONSTEXPR raw_t to_raw(const T& value)
+		{
+			return detail::bit_cast<raw_t>(base_t(value));
+		}
+
+		static ENDIAN_CONSTEXPR T from_raw(const raw_t& value)
+		{
+			return detail::bit_cast<base_t>(value).get();
+		}
+
+		// Compare-and-swap loop for arithmetic ops
+		template <typename Op>
+		T fetch_op(Op op, std::memory_order order)
+		{
+			raw_t old = data.load(std::memory_order_relaxed);
+
+			while (!data.compare_exchange_weak(old, to_raw(op(from_raw(old))), order, std::memory_order_relaxed))
+			{
+			}
+
+			return from_raw(old);
+		}
+
+	public:
+		using value_type = T;
+
+		atomic_endian_base() = default;
+
+		ENDIAN_CONSTEXPR atomic_endian_base(const T& value)
+		    : data(to_raw(value))
+		{
+		}
+
+		atomic_endian_base(const atomic_endian_base&) = delete;
+
+		atomic_endian_base& operator=(const atomic_endian_base&) = delete;
+
+		T operator=(const T& value)
+		{
+			store(value);
+			return value;
+		}
+
+		operator T() const
+		{
+			return load();
+		}
+
+		bool is_lock_free() const
+		{
+			return data.is_lock_free();
+		}
+
+		T load(std::memory_order order = std::memory_order_seq_cst) const
+		{
+			return from_raw(data.load(order));
+		}
+
+		void store(const T& value, std::memory_order order = std::memory_order_seq_cst)
+		{
+			data.store(to_raw(value), order);
+		}
+
+		T exchange(const T& value, std::memory_order order = std::memory_order_seq_cst)
+		{
+			return from_raw(data.exchange(to_raw(value), order));
+		}
+
+		// Compares storage (like std::atomic, this is bitwise comparison)
+		bool compare_exchange_weak(T& expected, const T& desired, std::memory_order order = std::memory_order_seq_cst)
+		{
+			raw_t old = to_raw(expected);
+			const bool result = data.compare_exchange_weak(old, to_raw(desired), order);
+			expected = from_raw(old);
+			return result;
+		}
+
+		bool compare_exchange_strong(T& expected, const T& desired, std::memory_order order = std::memory_order_seq_cst)
+		{
+			raw_t old = to_raw(expected);
+			const bool result = data.compare_exchange_strong(old, to_raw(desired), order);
+			expected = from_raw(old);
+			return result;
+		}
+
+		// Bitwise ops are performed on storage (no byteswap loop)
+		T fetch_and(const T& value, std::memory_order order = std::memory_order_seq_cst)
+		{
+			static_assert(detail::is_integer<T>::value, "atomic_endian_base<>::fetch_and: invalid type");
+			return from_raw(data.fetch_and(to_raw(value), order));
+		}
+
+		T fetch_or(const T& value, std::memory_order order = std::memory_order_seq_cst)
+		{
+			static_assert(detail::is_integer<T>::value, "atomic_endian_base<>::fetch_or: invalid type");
+			return from_raw(data.fetch_or(to_raw(value), order));
+		}
+
+		T fetch_xor(const T& value, std::memory_order order = std::memory_order_seq_cst)
+		{
+			static_assert(detail::is_integer<T>::value, "atomic_endian_base<>::fetch_xor: invalid type");
+			return from_raw(data.fetch_xor(to_raw(value), order));
+		}
+
+		T fetch_add(const T& value, std::memory_order order = std::memory_order_seq_cst)
+		{
+			return Native && detail::is_integer<T>::value ? from_raw(data.fetch_add(to_raw(value), order)) : fetch_op([&](T old) { return static_cast<T>(old + value); }, order);
+		}
+
+		T fetch_sub(const T& value, std::memory_order order = std::memory_order_seq_cst)
+		{
+			return Native && detail::is_integer<T>::value ? from_raw(data.fetch_sub(to_raw(value), order)) : fetch_op([&](T old) { return static_cast<T>(old - value); }, order);
+		}
+
+		T operator&=(const T& value)
+		{
+			return fetch_and(value) & value;
+		}
+
+		T operator|=(const T& value)
+		{
+			return fetch_or(value) | value;
+		}
+
+		T operator^=(const T& value)
+		{
+			return fetch_xor(value) ^ value;
+		}
+
+		T operator+=(const T& value)
+		{
+			return static_cast<T>(fetch_add(value) + value);
+		}
+
+		T operator-=(const T& value)
+		{
+			return static_cast<T>(fetch_sub(value) - value);
+		}
+
+		T operator++()
+		{
+			return *this += 1;
+		}
+
+		T operator--()
+		{
+			return *this -= 1;
+		}
+
+		T operator++(int)
+		{
+			return fetch_add(1);
+		}
+
+		T operator--(int)
+		{
+			return fetch_sub(1);
+		}
+	};
+
+	template <typename T>
+	using atomic_le_t = atomic_endian_base<T, endian::native == endian::little>;
+
+	template <typename T>
+	using atomic_be_t = atomic_endian_base<T, endian::native == endian::big>;
+
+	namespace detail
+	{
+		// Native SIMD vector type of given size (byte array if not available)
+		template <std::size_t Bytes>
+		struct vec_type
+		{
+			struct type
+			{
+				uchar data[Bytes];
+			};
+		};
+
+#if defined(ENDIAN_X86) && (defined(__SSE2__) || defined(_M_X64))
+		template <>
+		struct vec_type<16>
+		{
+			using type = __m128i;
+		};
+#endif
+#if defined(ENDIAN_X86) && defined(__AVX__)
+		template <>
+		struct vec_type<32>
+		{
+			using type = __m256i;
+		};
+#endif
+#if defined(ENDIAN_X86) && defined(__AVX512F__)
+		template <>
+		struct vec_type<64>
+		{
+			using type = __m512i;
+		};
+#endif
+#if defined(ENDIAN_NEON)
+		template <>
+		struct vec_type<16>
+		{
+			using type = uint8x16_t;
+		};
+#endif
+
+		// Vector load/store with byteswap of Size-byte elements (generic: through temporary)
+		template <std::size_t Size, bool Swap, typename V>
+		inline V vec_load(const uchar* src, V*)
+		{
+			uchar bytes[sizeof(V)];
+			Swap ? bswap_n_generic<Size>(bytes, src, sizeof(V) / Size) : static_cast<void>(std::memcpy(bytes, src, sizeof(V)));
+			V result;
+			std::memcpy(&result, bytes, sizeof(V));
+			return result;
+		}
+
+		template <std::size_t Size, bool Swap, typename V>
+		inline void vec_store(uchar* dst, const V& value)
+		{
+			uchar bytes[sizeof(V)];
+			std::memcpy(bytes, &value, sizeof(V));
+			Swap ? bswap_n_generic<Size>(dst, bytes, sizeof(V) / Size) : static_cast<void>(std::memcpy(dst, bytes, sizeof(V)));
+		}
+
+#if defined(ENDIAN_X86) && (defined(__SSE2__) || defined(_M_X64))
+#if defined(__SSSE3__)
+		template <std::size_t Size>
+		inline __m128i vec_swap128(__m128i v, std::integral_constant<std::size_t, Size>)
+		{
+			return _mm_shuffle_epi8(v, _mm_load_si128(reinterpret_cast<const __m128i*>(bswap_mask<Size>())));
+		}
+#else
+		// SSE2: shuffle 16-bit words, then swap bytes within words (16-bit rotate by 8)
+		inline __m128i vec_swap_words(__m128i v)
+		{
+			return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		}
+
+		inline __m128i vec_swap128(__m128i v, std::integral_constant<std::size_t, 1>)
+		{
+			return v;
+		}
+
+		inline __m128i vec_swap128(__m128i v, std::integral_constant<std::size_t, 2>)
+		{
+			return vec_swap_words(v);
+		}
+
+		inline __m128i vec_swap128(__m128i v, std::integral_constant<std::size_t, 4>)
+		{
+			return vec_swap_words(_mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1)));
+		}
+
+		inline __m128i vec_swap128(__m128i v, std::integral_constant<std::size_t, 8>)
+		{
+			return vec_swap_words(_mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3)));
+		}
+
+		inline __m128i vec_swap128(__m128i v, std::integral_constant<std::size_t, 16>)
+		{
+			return _mm_shuffle_epi32(vec_swap128(v, std::integral_constant<std::size_t, 8>()), _MM_SHUFFLE(1, 0, 3, 2));
+		}
+#endif
+
+		template <std::size_t Size, bool Swap>
+		inline __m128i vec_load(const uchar* src, __m128i*)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+			return Swap ? vec_swap128(v, std::integral_constant<std::size_t, Size>()) : v;
+		}
+
+		template <std::size_t Size, bool Swap>
+		inline void vec_store(uchar* dst, const __m128i& value)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), Swap ? vec_swap128(value, std::integral_constant<std::size_t, Size>()) : value);
+		}
+#endif
+#if defined(ENDIAN_X86) && defined(__AVX__)
+#if defined(__AVX2__)
+		template <std::size_t Size>
+		inline __m256i vec_swap256(__m256i v)
+		{
+			return _mm256_shuffle_epi8(v, _mm256_load_si256(reinterpret_cast<const __m256i*>(bswap_mask<Size>())));
+		}
+#else
+		// AVX without AVX2: swap 128-bit halves separately (elements don't cross them)
+		template <std::size_t Size>
+		inline __m256i vec_swap256(__m256i v)
+		{
+			const std::integral_constant<std::size_t, Size> size{};
+			const __m128i lo = vec_swap128(_mm256_castsi256_si128(v), size);
+			const __m128i hi = vec_swap128(_mm256_extractf128_si256(v, 1), size);
+			return _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1);
+		}
+#endif
+
+		template <std::size_t Size, bool Swap>
+		inline __m256i vec_load(const uchar* src, __m256i*)
+		{
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+			return Swap ? vec_swap256<Size>(v) : v;
+		}
+
+		template <std::size_t Size, bool Swap>
+		inline void vec_store(uchar* dst, const __m256i& value)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), Swap ? vec_swap256<Size>(value) : value);
+		}
+#endif
+#if defined(ENDIAN_X86) && defined(__AVX512F__)
+#if defined(__AVX512BW__)
+		template <std::size_t Size>
+		inline __m512i vec_swap512(__m512i v)
+		{
+			return _mm512_shuffle_epi8(v, _mm512_load_si512(bswap_mask<Size>()));
+		}
+#else
+		// AVX-512F without BW (Knights Landing): swap 256-bit halves separately through memory
+		template <std::size_t Size>
+		inline __m512i vec_swap512(__m512i v)
+		{
+			alignas(64) uchar bytes[64];
+			_mm512_store_si512(bytes, v);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(bytes), vec_swap256<Size>(_mm256_load_si256(reinterpret_cast<const __m256i*>(bytes))));
+			_mm256_store_si256(reinterpret_cast<__m256i*>(bytes + 32), vec_swap256<Size>(_mm256_load_si256(reinterpret_cast<const __m256i*>(bytes + 32))));
+			return _mm512_load_si512(bytes);
+		}
+#endif
+
+		template <std::size_t Size, bool Swap>
+		inline __m512i vec_load(const uchar* src, __m512i*)
+		{
+			const __m512i v = _mm512_loadu_si512(src);
+			return Swap ? vec_swap512<Size>(v) : v;
+		}
+
+		template <std::size_t Size, bool Swap>
+		inline void vec_store(uchar* dst, const __m512i& value)
+		{
+			_mm512_storeu_si512(dst, Swap ? vec_swap512<Size>(value) : value);
+		}
+#endif
+#if defined(ENDIAN_NEON)
+		inline uint8x16_t vec_swap(uint8x16_t v, std::integral_constant<std::size_t, 2>)
+		{
+			return vrev16q_u8(v);
+		}
+
+		inline uint8x16_t vec_swap(uint8x16_t v, std::integral_constant<std::size_t, 4>)
+		{
+			return vrev32q_u8(v);
+		}
+
+		inline uint8x16_t vec_swap(uint8x16_t v, std::integral_constant<std::size_t, 8>)
+		{
+			return vrev64q_u8(v);
+		}
+
+		inline uint8x16_t vec_swap(uint8x16_t v, std::integral_constant<std::size_t, 16>)
+		{
+			return vextq_u8(vrev64q_u8(v), vrev64q_u8(v), 8);
+		}
+
+		template <std::size_t Size, bool Swap>
+		inline uint8x16_t vec_load(const uchar* src, uint8x16_t*)
+		{
+			const uint8x16_t v = vld1q_u8(src);
+			return Swap ? vec_swap(v, std::integral_constant<std::size_t, Size>()) : v;
+		}
+
+		template <std::size_t Size, bool Swap>
+		inline void vec_store(uchar* dst, const uint8x16_t& value)
+		{
+			vst1q_u8(dst, Swap ? vec_swap(value, std::integral_constant<std::size_t, Size>()) : value);
+		}
+#endif
+	}
+
+	// SIMD counterpart of endian_base: N elements of T in LE/BE order, loaded/stored as native vector with the swap folded in
+	// (pshufb on x86, rev on ARM). native_type is SIMD integer vector type (__m128i, __m256i, __m512i, uint8x16_t)
+	// if enabled by compiler options, and a byte array struct otherwise.
+	template <typename T, std::size_t N, bool Native>
+	class endian_vec
+	{
+		static_assert(has_endianness<T>::value, "endian_vec<>: invalid type");
+
+		static constexpr std::size_t esize = sizeof(endian_base<T, 1, Native>);
+
+		endian_base<T, 1, Native> m_data[N];
+
+	public:
+		using value_type = T;
+		using element_type = endian_base<T, 1, Native>;
+		using native_type = typename detail::vec_type<esize * N>::type;
+
+		static_assert(sizeof(native_type) == esize * N, "endian_vec<>: invalid vector size");
+
+		endian_vec() = default;
+
+		endian_vec(const native_type& value)
+		{
+			store(m_data, value);
+		}
+
+		endian_vec& operator=(const native_type& value)
+		{
+			store(m_data, value);
+			return *this;
+		}
+
+		operator native_type() const
+		{
+			return load(m_data);
+		}
+
+		native_type get() const
+		{
+			return load(m_data);
+		}
+
+		// Load vector from unaligned memory (LE/BE) as native vector
+		static native_type load(const void* src)
+		{
+			return detail::vec_load<esize, !Native && esize != 1>(static_cast<const detail::uchar*>(src), static_cast<native_type*>(nullptr));
+		}
+
+		// Store native vector to unaligned memory as LE/BE
+		static void store(void* dst, const native_type& value)
+		{
+			detail::vec_store<esize, !Native && esize != 1>(static_cast<detail::uchar*>(dst), value);
+		}
+
+		// Shuffle mask (pshufb/tbl) for conversion (identity if Native)
+		static native_type mask()
+		{
+			static_assert(sizeof(native_type) <= 64, "endian_vec<>::mask: vector too big");
+
+			native_type result;
+			std::memcpy(&result, detail::bswap_mask<Native ? 1 : esize>(), sizeof(result));
+			return result;
+		}
+
+		static constexpr std::size_t size()
+		{
+			return N;
+		}
+
+		element_type& operator[](std::size_t index)
+		{
+			return m_data[index];
+		}
+
+		const element_type& operator[](std::size_t index) const
+		{
+			return m_data[index];
+		}
+	};
+
+	template <typename T, std::size_t N>
+	using le_vec = endian_vec<T, N, endian::native == endian::little>;
+
+	template <typename T, std::size_t N>
+	using be_vec = endian_vec<T, N, endian::native == endian::big>;
+
+	// Base address policy for endian_ptr: global base pointer (Tag allows multiple address spaces)
+	template <typename Tag = void>
+	struct global_base
+	{
+		static detail::uchar*& ref()
+		{
+			static detail::uchar* ptr = nullptr;
+			return ptr;
+		}
+
+		static detail::uchar* base()
+		{
+			return ref();
+		}
+
+		static void set(void* ptr)
+		{
+			ref() = static_cast<detail::uchar*>(ptr);
+		}
+	};
+
+	// Thread-local base pointer
+	template <typename Tag = void>
+	struct thread_base
+	{
+		static detail::uchar*& ref()
+		{
+			static thread_local detail::uchar* ptr = nullptr;
+			return ptr;
+		}
+
+		static detail::uchar* base()
+		{
+			return ref();
+		}
+
+		static void set(void* ptr)
+		{
+			ref() = static_cast<detail::uchar*>(ptr);
+		}
+	};
+
+	namespace detail
+	{
+		// Pointee: endian_base<T> for arithmetic/enum types, T itself otherwise (structures of le_t/be_t, endian_ptr...)
+		template <typename T, bool Native, bool = has_endianness<typename std::remove_cv<T>::type>::value>
+		struct ptr_element
+		{
+			using type = T;
+		};
+
+		template <typename T, bool Native>
+		struct ptr_element<T, Native, true>
+		{
+			using base = endian_base<typename std::remove_cv<T>::type, alignof(T), Native>;
+			using type = typename std::conditional<std::is_const<T>::value, const base, base>::type;
+		};
+	}
+
+	// 32-bit LE/BE offset relative to Base::base() (guest address space), dereferences to le_t<T>/be_t<T>.
+	// Trivially copyable and 4 bytes, can be used in LE/BE structures. No checks: null is the base address.
+	template <typename T, typename Base, bool Native>
+	class endian_ptr
+	{
+		endian_base<std::uint32_t, alignof(std::uint32_t), Native> m_addr;
+
+	public:
+		using element_type = typename detail::ptr_element<T, Native>::type;
+		using difference_type = std::int32_t;
+
+		endian_ptr() = default;
+
+		ENDIAN_CONSTEXPR endian_ptr(std::nullptr_t)
+			: m_addr(0u)
+		{
+		}
+
+		// Conversion to const T* or void* (not to base class: the offset of base subobject isn't applied)
+		template <typename T2, typename = typename std::enable_if<std::is_convertible<typename detail::ptr_element<T2, Native>::type*, element_type*>::value &&
+			(std::is_void<T>::value || std::is_same<typename std::remove_cv<T2>::type, typename std::remove_cv<T>::type>::value)>::type>
+		ENDIAN_CONSTEXPR endian_ptr(const endian_ptr<T2, Base, Native>& rhs)
+			: m_addr(rhs.addr())
+		{
+		}
+
+		// From host pointer (must point into the address space)
+		explicit endian_ptr(element_type* ptr)
+			: m_addr(static_cast<std::uint32_t>(reinterpret_cast<const detail::uchar*>(ptr) - Base::base()))
+		{
+		}
+
+		static ENDIAN_CONSTEXPR endian_ptr from_addr(std::uint32_t addr)
+		{
+			return endian_ptr(addr, 0);
+		}
+
+		ENDIAN_CONSTEXPR std::uint32_t addr() const
+		{
+			return m_addr;
+		}
+
+		// Host pointer: byteswap, add, no checks
+		element_type* get() const
+		{
+			return reinterpret_cast<element_type*>(Base::base() + m_addr.get());
+		}
+
+		template <typename E = element_type>
+		E& operator*() const
+		{
+			return *get();
+		}
+
+		element_type* operator->() const
+		{
+			return get();
+		}
+
+		template <typename E = element_type>
+		E& operator[](difference_type index) const
+		{
+			return get()[index];
+		}
+
+		ENDIAN_CONSTEXPR explicit operator bool() const
+		{
+			return m_addr.get() != 0;
+		}
+
+		// Pointer arithmetic (32-bit wraparound)
+		endian_ptr& operator+=(difference_type n)
+		{
+			m_addr = m_addr.get() + static_cast<std::uint32_t>(n) * static_cast<std::uint32_t>(sizeof(element_type));
+			return *this;
+		}
+
+		endian_ptr& operator-=(difference_type n)
+		{
+			m_addr = m_addr.get() - static_cast<std::uint32_t>(n) * static_cast<std::uint32_t>(sizeof(element_type));
+			return *this;
+		}
+
+		endian_ptr& operator++()
+		{
+			return *this += 1;
+		}
+
+		endian_ptr& operator--()
+		{
+			return *this -= 1;
+		}
+
+		endian_ptr operator++(int)
+		{
+			endian_ptr result = *this;
+			*this += 1;
+			return result;
+		}
+
+		endian_ptr operator--(int)
+		{
+			endian_ptr result = *this;
+			*this -= 1;
+			return result;
+		}
+
+		friend endian_ptr operator+(endian_ptr ptr, difference_type n)
+		{
+			return ptr += n;
+		}
+
+		friend endian_ptr operator+(difference_type n, endian_ptr ptr)
+		{
+			return ptr += n;
+		}
+
+		friend endian_ptr operator-(endian_ptr ptr, difference_type n)
+		{
+			return ptr -= n;
+		}
+
+		friend difference_type operator-(const endian_ptr& lhs, const endian_ptr& rhs)
+		{
+			return static_cast<difference_type>(lhs.addr() - rhs.addr()) / static_cast<difference_type>(sizeof(element_type));
+		}
+
+		// Comparison (on storage for == and !=)
+		friend ENDIAN_CONSTEXPR bool operator==(const endian_ptr& lhs, const endian_ptr& rhs)
+		{
+			return lhs.m_addr == rhs.m_addr;
+		}
+
+		friend ENDIAN_CONSTEXPR bool operator!=(const endian_ptr& lhs, const endian_ptr& rhs)
+		{
+			return lhs.m_addr != rhs.m_addr;
+		}
+
+		friend ENDIAN_CONSTEXPR bool operator<(const endian_ptr& lhs, const endian_ptr& rhs)
+		{
+			return lhs.addr() < rhs.addr();
+		}
+
+		friend ENDIAN_CONSTEXPR bool operator>(const endian_ptr& lhs, const endian_ptr& rhs)
+		{
+			return lhs.addr() > rhs.addr();
+		}
+
+		friend ENDIAN_CONSTEXPR bool operator<=(const endian_ptr& lhs, const endian_ptr& rhs)
+		{
+			return lhs.addr() <= rhs.addr();
+		}
+
+		friend ENDIAN_CONSTEXPR bool operator>=(const endian_ptr& lhs, const endian_ptr& rhs)
+		{
+			return lhs.addr() >= rhs.addr();
+		}
+
+	private:
+		ENDIAN_CONSTEXPR endian_ptr(std::uint32_t addr, int)
+			: m_addr(addr)
+		{
+		}
+	};
+
+	template <typename T, typename Base = global_base<>>
+	using le_ptr = endian_ptr<T, Base, endian::native == endian::little>;
+
+	template <typename T, typename Base = global_base<>>
+	using be_ptr = endian_ptr<T, Base, endian::native == endian::big>;
+
+	// Bit field of LE/BE word: `Width` bits at `Offset` (from the least significant bit of the value).
+	// Has the same size and alignment as endian_base<T, Align, Native> and can be used in a union with it.
+	// Mask and shift are computed in storage byte order: fields within one byte are accessed without byteswap,
+	// other fields are masked on storage and only the field (or the new value) is swapped.
+	template <typename T, std::size_t Offset, std::size_t Width, bool Native, std::size_t Align = alignof(T)>
+	class endian_bitfield
+	{
+		static_assert(std::is_unsigned<T>::value && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8), "endian_bitfield<>: invalid type");
+		static_assert(Width > 0 && Offset + Width <= sizeof(T) * 8, "endian_bitfield<>: invalid range");
+
+		using raw_t = typename detail::uint_of_size<sizeof(T)>::type;
+		using buf = detail::endian_buffer<raw_t, sizeof(T), Align>;
+
+		typename buf::type data;
+
+		static constexpr raw_t value_mask = Width == sizeof(T) * 8 ? static_cast<raw_t>(-1) : static_cast<raw_t>((raw_t{1} << Width) - 1);
+
+		// Field is contained in one byte: shift in storage (raw_t loaded in native order)
+		static constexpr bool in_byte = Offset % 8 + Width <= 8;
+		static constexpr std::size_t byte_pos = Native ? Offset / 8 : sizeof(T) - 1 - Offset / 8;
+		static constexpr std::size_t byte_shift = (endian::native == endian::little ? byte_pos : sizeof(T) - 1 - byte_pos) * 8 + Offset % 8;
+
+		static ENDIAN_CONSTEXPR raw_t swap(raw_t value)
+		{
+			using sbuf = detail::endian_buffer<raw_t, sizeof(T), sizeof(T)>;
+			return Native || sizeof(T) == 1 ? value : static_cast<raw_t>(sbuf::get_re(detail::bit_cast<typename sbuf::type>(value)));
+		}
+
+		ENDIAN_CONSTEXPR raw_t raw() const
+		{
+			return buf::template get_raw<raw_t>(data);
+		}
+
+		ENDIAN_CONSTEXPR T get(std::true_type) const
+		{
+			return static_cast<T>(raw() >> byte_shift & value_mask);
+		}
+
+		ENDIAN_CONSTEXPR T get(std::false_type) const
+		{
+			return static_cast<T>(swap(raw() & mask()) >> Offset);
+		}
+
+		ENDIAN_CONSTEXPR void set(T value, std::true_type)
+		{
+			const raw_t m = static_cast<raw_t>(value_mask << byte_shift);
+			buf::put_raw(data, static_cast<raw_t>((raw() & ~m) | (static_cast<raw_t>(value) << byte_shift & m)));
+		}
+
+		ENDIAN_CONSTEXPR void set(T value, std::false_type)
+		{
+			buf::put_raw(data, static_cast<raw_t>((raw() & ~mask()) | (swap(static_cast<raw_t>(static_cast<raw_t>(value) << Offset)) & mask())));
+		}
+
+	public:
+		using value_type = T;
+
+		// Field mask in storage representation (as raw_t loaded in native order)
+		static ENDIAN_CONSTEXPR raw_t mask()
+		{
+			return swap(static_cast<raw_t>(value_mask << Offset));
+		}
+
+		endian_bitfield() = default;
+
+		ENDIAN_CONSTEXPR endian_bitfield(T value)
+			: data{}
+		{
+			set(value);
+		}
+
+		endian_bitfield& operator=(const endian_bitfield&) = default;
+
+		ENDIAN_CONSTEXPR endian_bitfield& operator=(T value)
+		{
+			set(value);
+			return *this;
+		}
+
+		ENDIAN_CONSTEXPR operator T() const
+		{
+			return get();
+		}
+
+		ENDIAN_CONSTEXPR T get() const
+		{
+			return get(std::integral_constant<bool, in_byte>());
+		}
+
+		// Store value truncated to `Width` bits (other bits of the word are preserved)
+		ENDIAN_CONSTEXPR void set(T value)
+		{
+			set(value, std::integral_constant<bool, in_byte>());
+		}
+	};
+
+	template <typename T, std::size_t Offset, std::size_t Width, std::size_t Align = alignof(T)>
+	using le_bitfield = endian_bitfield<T, Offset, Width, endian::native == endian::little, Align>;
+
+	template <typename T, std::size_t Offset, std::size_t Width, std::size_t Align = alignof(T)>
+	using be_bitfield = endian_bitfield<T, Offset, Width, endian::native == endian::big, Align>;
+
+	// Convert n values to native order in place and return them as a native array.
+	// Returned pointer is only suitably aligned for T if the storage is (for example, Align = 1 isn't).
+	// Always uses temporal stores: the data is expected to be read soon.
+	template <typename T, std::size_t A, bool Native>
+	T* byteswap_inplace(endian_base<T, A, Native>* data, std::size_t n)
+	{
+		static_assert(sizeof(endian_base<T, A, Native>) == sizeof(T), "byteswap_inplace<>: over-aligned elements");
+
+		if (!Native)
+		{
+			detail::copy_n_re<sizeof(T)>(data, data, n, bulk_store::temporal);
+		}
+
+		return reinterpret_cast<T*>(data);
+	}
+
+#if defined(__cpp_lib_span)
+	template <typename T, std::size_t A, bool Native>
+	std::span<T> byteswap_inplace(std::span<endian_base<T, A, Native>> data)
+	{
+		return {byteswap_inplace(data.data(), data.size()), data.size()};
+	}
+#endif
+
+	template <typename E>
+	class native_view;
+
+	// Scoped native view of LE/BE array: converted in place on construction, converted back on destruction.
+	// The array must not be accessed as LE/BE values while the view exists.
+	template <typename T, std::size_t A, bool Native>
+	class native_view<endian_base<T, A, Native>>
+	{
+		static_assert(A >= alignof(T), "native_view<>: under-aligned elements (use byteswap_inplace)");
+
+		T* m_data = nullptr;
+		std::size_t m_size = 0;
+
+	public:
+		using value_type = T;
+		using iterator = T*;
+
+		native_view() = default;
+
+		native_view(endian_base<T, A, Native>* data, std::size_t n)
+			: m_data(byteswap_inplace(data, n))
+			, m_size(n)
+		{
+		}
+
+#if defined(__cpp_lib_span)
+		explicit native_view(std::span<endian_base<T, A, Native>> data)
+			: native_view(data.data(), data.size())
+		{
+		}
+#endif
+
+		native_view(const native_view&) = delete;
+
+		native_view(native_view&& rhs) noexcept
+			: m_data(rhs.m_data)
+			, m_size(rhs.m_size)
+		{
+			rhs.m_data = nullptr;
+			rhs.m_size = 0;
+		}
+
+		native_view& operator=(native_view rhs) noexcept
+		{
+			std::swap(m_data, rhs.m_data);
+			std::swap(m_size, rhs.m_size);
+			return *this;
+		}
+
+		~native_view()
+		{
+			reset();
+		}
+
+		// Convert back now (the view becomes empty)
+		void reset()
+		{
+			if (!Native && m_data)
+			{
+				detail::copy_n_re<sizeof(T)>(m_data, m_data, m_size, bulk_store::temporal);
+			}
+
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+		T* data() const
+		{
+			return m_data;
+		}
+
+		std::size_t size() const
+		{
+			return m_size;
+		}
+
+		T* begin() const
+		{
+			return m_data;
+		}
+
+		T* end() const
+		{
+			return m_data + m_size;
+		}
+
+		T& operator[](std::size_t index) const
+		{
+			return m_data[index];
+		}
+
+#if defined(__cpp_lib_span)
+		operator std::span<T>() const
+		{
+			return {m_data, m_size};
+		}
+#endif
+	};
+
+#if defined(__cpp_deduction_guides)
+	template <typename T, std::size_t A, bool Native>
+	native_view(endian_base<T, A, Native>*, std::size_t) -> native_view<endian_base<T, A, Native>>;
+#if defined(__cpp_lib_span)
+	template <typename T, std::size_t A, bool Native>
+	native_view(std::span<endian_base<T, A, Native>>) -> native_view<endian_base<T, A, Native>>;
+#endif
+#endif
+
+	namespace detail
+	{
+		// Byte order of record field: size of swapped elements (0 if none), their count and stride
+		template <typename F>
+		struct record_field
+		{
+			static constexpr std::size_t swap = 0;
+			static constexpr std::size_t count = 1;
+			static constexpr std::size_t stride = sizeof(F);
+		};
+
+		template <typename T, std::size_t A, bool Native>
+		struct record_field<endian_base<T, A, Native>>
+		{
+			static constexpr std::size_t swap = Native ? 0 : sizeof(T);
+			static constexpr std::size_t count = 1;
+			static constexpr std::size_t stride = sizeof(endian_base<T, A, Native>);
+		};
+
+		template <typename F, std::size_t N>
+		struct record_field<F[N]>
+		{
+			static constexpr std::size_t swap = record_field<F>::swap;
+			static constexpr std::size_t count = record_field<F>::count * N;
+			static constexpr std::size_t stride = record_field<F>::stride;
+		};
+
+		constexpr std::size_t align_up(std::size_t value, std::size_t align)
+		{
+			return (value + align - 1) / align * align;
+		}
+
+		// Field offset (same as in struct with the same members), index == field count gives unaligned end
+		template <typename... Fields>
+		constexpr std::size_t record_offset(std::size_t index)
+		{
+			const std::size_t size[]{sizeof(Fields)..., 0};
+			const std::size_t align[]{alignof(Fields)..., 1};
+
+			std::size_t offset = 0;
+
+			for (std::size_t i = 0; i < index; i++)
+			{
+				offset = align_up(offset, align[i]) + size[i];
+			}
+
+			return align_up(offset, align[index]);
+		}
+
+		template <typename... Fields>
+		constexpr std::size_t record_size()
+		{
+			const std::size_t align[]{alignof(Fields)...};
+
+			std::size_t max_align = 1;
+
+			for (std::size_t a : align)
+			{
+				max_align = a > max_align ? a : max_align;
+			}
+
+			return align_up(record_offset<Fields...>(sizeof...(Fields)), max_align);
+		}
+
+		template <std::size_t N>
+		struct shuffle_mask
+		{
+			uchar data[N];
+		};
+
+		// Shuffle mask (pshufb-like) for as many whole records as fit in N bytes, other bytes are unchanged
+		template <std::size_t N, typename... Fields>
+		constexpr shuffle_mask<N> record_mask()
+		{
+			const std::size_t swap[]{record_field<Fields>::swap...};
+			const std::size_t count[]{record_field<Fields>::count...};
+			const std::size_t stride[]{record_field<Fields>::stride...};
+			const std::size_t size = record_size<Fields...>();
+
+			shuffle_mask<N> result{};
+
+			for (std::size_t i = 0; i < N; i++)
+			{
+				result.data[i] = static_cast<uchar>(i);
+			}
+
+			for (std::size_t base = 0; base + size <= N; base += size)
+			{
+				for (std::size_t f = 0; f < sizeof...(Fields); f++)
+				{
+					for (std::size_t e = 0; e < count[f]; e++)
+					{
+						const std::size_t offset = base + record_offset<Fields...>(f) + e * stride[f];
+
+						for (std::size_t b = 0; b < swap[f]; b++)
+						{
+							result.data[offset + b] = static_cast<uchar>(offset + swap[f] - 1 - b);
+						}
+					}
+				}
+			}
+
+			return result;
+		}
+
+		// Byteswap record field in place
+		template <typename F>
+		inline void record_swap_field(uchar*, std::integral_constant<std::size_t, 0>)
+		{
+		}
+
+		template <typename F, std::size_t Swap>
+		inline void record_swap_field(uchar* ptr, std::integral_constant<std::size_t, Swap>)
+		{
+			for (std::size_t e = 0; e < record_field<F>::count; e++, ptr += record_field<F>::stride)
+			{
+				bswap_n_generic<Swap>(ptr, ptr, 1);
+			}
+		}
+
+		template <typename... Fields>
+		struct record_kernels
+		{
+			static constexpr std::size_t size = record_size<Fields...>();
+
+			template <std::size_t... I>
+			static ENDIAN_FORCEINLINE void swap_fields(uchar* ptr, std::index_sequence<I...>)
+			{
+				const int dummy[]{0, (record_swap_field<Fields>(ptr + std::integral_constant<std::size_t, record_offset<Fields...>(I)>::value, std::integral_constant<std::size_t, record_field<Fields>::swap>()), 0)...};
+				static_cast<void>(dummy);
+			}
+
+			// Convert records field by field (fallback algorithm, also used for tails)
+			static void convert_generic(uchar* dst, const uchar* src, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; i++, dst += size, src += size)
+				{
+					if (dst != src)
+					{
+						std::memcpy(dst, src, size);
+					}
+
+					swap_fields(dst, std::index_sequence_for<Fields...>());
+				}
+			}
+
+			template <std::size_t N>
+			static const uchar* mask()
+			{
+				alignas(64) static const shuffle_mask<N> result = record_mask<N, Fields...>();
+				return result.data;
+			}
+
+#if defined(ENDIAN_X86)
+			// Several whole records per 16-byte vector (size <= 16)
+			ENDIAN_TARGET("ssse3") static void convert_ssse3(uchar* dst, const uchar* src, std::size_t n)
+			{
+				const __m128i mask_v = _mm_load_si128(reinterpret_cast<const __m128i*>(mask<16>()));
+				const std::size_t step = 16 / size;
+
+				std::size_t i = 0;
+
+				// Bytes after the last whole record are stored unchanged (overwritten by the next iteration)
+				for (const std::size_t bytes = n * size; i * size + 16 <= bytes; i += step)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * size));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * size), _mm_shuffle_epi8(v, mask_v));
+				}
+
+				convert_generic(dst + i * size, src + i * size, n - i);
+			}
+
+			// Several whole records per 64-byte vector (size <= 64), masked loads/stores handle the tail
+			ENDIAN_TARGET("avx512f,avx512bw,avx512vbmi") static void convert_avx512(uchar* dst, const uchar* src, std::size_t n)
+			{
+				const __m512i mask_v = _mm512_load_si512(mask<64>());
+				const std::size_t step = 64 / size;
+
+				for (std::size_t i = 0; i < n; i += step)
+				{
+					const std::size_t bytes = (n - i < step ? n - i : step) * size;
+					const __mmask64 k = bytes == 64 ? ~__mmask64{0} : (__mmask64{1} << bytes) - 1;
+					const __m512i v = _mm512_maskz_loadu_epi8(k, src + i * size);
+					_mm512_mask_storeu_epi8(dst + i * size, k, _mm512_maskz_permutexvar_epi8(k, mask_v, v));
+				}
+			}
+#elif defined(ENDIAN_NEON) && defined(__aarch64__)
+			static void convert_neon(uchar* dst, const uchar* src, std::size_t n)
+			{
+				const uint8x16_t mask_v = vld1q_u8(mask<16>());
+				const std::size_t step = 16 / size;
+
+				std::size_t i = 0;
+
+				for (const std::size_t bytes = n * size; i * size + 16 <= bytes; i += step)
+				{
+					vst1q_u8(dst + i * size, vqtbl1q_u8(vld1q_u8(src + i * size), mask_v));
+				}
+
+				convert_generic(dst + i * size, src + i * size, n - i);
+			}
+#endif
+
+			static bswap_n_func select()
+			{
+#if defined(ENDIAN_X86_DISPATCH)
+				__builtin_cpu_init();
+
+				if (size <= 64 && __builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512bw"))
+					return convert_avx512;
+				if (size <= 16 && __builtin_cpu_supports("ssse3"))
+					return convert_ssse3;
+#elif defined(ENDIAN_X86) && defined(__AVX512VBMI__)
+				if (size <= 64)
+					return convert_avx512;
+#elif defined(ENDIAN_X86) && (defined(__SSSE3__) || defined(__AVX__))
+				if (size <= 16)
+					return convert_ssse3;
+#elif defined(ENDIAN_NEON) && defined(__aarch64__)
+				if (size <= 16)
+					return convert_neon;
+#endif
+				return convert_generic;
+			}
+		};
+	}
+
+	// Record layout: same layout as struct with `Fields` members (le_t, be_t, other types and arrays)
+	template <typename... Fields>
+	struct endian_record
+	{
+		static_assert(sizeof...(Fields) > 0, "endian_record<>: no fields");
+
+		static constexpr std::size_t size = detail::record_size<Fields...>();
+
+		// Field offset
+		static constexpr std::size_t offset(std::size_t index)
+		{
+			return detail::record_offset<Fields...>(index);
+		}
+
+		// Convert n records between LE/BE and native byte order in every field (dst == src is allowed).
+		// The result has the same layout as struct with native type members of the same alignment.
+		static void convert_n(void* dst, const void* src, std::size_t n)
+		{
+			using kernels = detail::record_kernels<Fields...>;
+
+			static const detail::bswap_n_func func = kernels::select();
+			func(static_cast<detail::uchar*>(dst), static_cast<const detail::uchar*>(src), n);
+		}
+	};
+
+	// Packed integer of `Bits` width (multiple of 8, up to 64) in LE/BE byte order (alignment 1).
+	// Value type is 32-bit or 64-bit integer, sign-extended if `Signed`.
+	template <std::size_t Bits, bool Signed, bool Native>
+	class endian_int
+	{
+		static_assert(Bits % 8 == 0 && Bits >= 8 && Bits <= 64, "endian_int<>: invalid size");
+
+		static constexpr std::size_t size = Bits / 8;
+
+		using uint_t = std::conditional_t<(size <= 4), std::uint32_t, std::uint64_t>;
+		using buf = detail::endian_buffer<uint_t, sizeof(uint_t), sizeof(uint_t)>;
+
+		// Position of stored bytes in uint_t representation (before byteswap if not Native)
+		static constexpr std::size_t offset = Native == (endian::native == endian::little) ? 0 : sizeof(uint_t) - size;
+
+		static constexpr uint_t sign = uint_t{1} << (Bits - 1);
+
+		detail::uchar data[size];
+
+	public:
+		using value_type = std::conditional_t<Signed, std::make_signed_t<uint_t>, uint_t>;
+
+		endian_int() = default;
+
+		ENDIAN_CONSTEXPR endian_int(value_type value)
+		    : data{}
+		{
+			set(value);
+		}
+
+		endian_int& operator=(const endian_int&) = default;
+
+		ENDIAN_CONSTEXPR endian_int& operator=(value_type value)
+		{
+			set(value);
+			return *this;
+		}
+
+		ENDIAN_CONSTEXPR operator value_type() const
+		{
+			return get();
+		}
+
+		ENDIAN_CONSTEXPR value_type get() const
+		{
+			detail::byte_array<sizeof(uint_t)> bytes{};
+			detail::copy_bytes<size>(bytes.data + offset, data);
+			const uint_t value = Native ? detail::bit_cast<uint_t>(bytes) : buf::load_re(bytes.data);
+
+			// Sign extension (xor + sub)
+			if (!Signed || Bits == sizeof(uint_t) * 8)
+			{
+				return static_cast<value_type>(value);
+			}
+
+			return static_cast<value_type>(value ^ sign) - static_cast<value_type>(sign);
+		}
+
+		// Store value (truncated to `Bits`)
+		ENDIAN_CONSTEXPR void set(value_type value)
+		{
+			detail::byte_array<sizeof(uint_t)> bytes{};
+
+			if (Native)
+			{
+				bytes = detail::bit_cast<detail::byte_array<sizeof(uint_t)>>(static_cast<uint_t>(value));
+			}
+			else
+			{
+				buf::store_re(bytes.data, static_cast<uint_t>(value));
+			}
+
+			detail::copy_bytes<size>(data, bytes.data + offset);
+		}
+
+		ENDIAN_CONSTEXPR auto operator++(int)
+		{
+			auto val = get();
+			auto result = val++;
+			*this = val;
+			return result;
+		}
+
+		ENDIAN_CONSTEXPR auto operator--(int)
+		{
+			auto val = get();
+			auto result = val--;
+			*this = val;
+			return result;
+		}
+
+		ENDIAN_CONSTEXPR endian_int& operator++()
+		{
+			auto val = get();
+			++val;
+			return (*this = val);
+		}
+
+		ENDIAN_CONSTEXPR endian_int& operator--()
+		{
+			auto val = get();
+			--val;
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_int& operator+=(T2&& rhs)
+		{
+			auto val = get();
+			val += std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_int& operator-=(T2&& rhs)
+		{
+			auto val = get();
+			val -= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_int& operator*=(T2&& rhs)
+		{
+			auto val = get();
+			val *= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_int& operator/=(T2&& rhs)
+		{
+			auto val = get();
+			val /= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_int& operator%=(T2&& rhs)
+		{
+			auto val = get();
+			val %= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_int& operator&=(T2&& rhs)
+		{
+			auto val = get();
+			val &= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_int& operator|=(T2&& rhs)
+		{
+			auto val = get();
+			val |= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_int& operator^=(T2&& rhs)
+		{
+			auto val = get();
+			val ^= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_int& operator<<=(T2&& rhs)
+		{
+			auto val = get();
+			val <<= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+
+		template <typename T2>
+		ENDIAN_CONSTEXPR endian_int& operator>>=(T2&& rhs)
+		{
+			auto val = get();
+			val >>= std::forward<T2>(rhs);
+			return (*this = val);
+		}
+	};
+
+	template <std::size_t Bits>
+	using le_int = endian_int<Bits, true, endian::native == endian::little>;
+
+	template <std::size_t Bits>
+	using le_uint = endian_int<Bits, false, endian::native == endian::little>;
+
+	template <std::size_t Bits>
+	using be_int = endian_int<Bits, true, endian::native == endian::big>;
+
+	template <std::size_t Bits>
+	using be_uint = endian_int<Bits, false, endian::native == endian::big>;
+
+	using le_int24_t = le_int<24>;
+	using le_uint24_t = le_uint<24>;
+	using le_int48_t = le_int<48>;
+	using le_uint48_t = le_uint<48>;
+	using be_int24_t = be_int<24>;
+	using be_uint24_t = be_uint<24>;
+	using be_int48_t = be_int<48>;
+	using be_uint48_t = be_uint<48>;
+
+	namespace detail
+	{
+		// Unpack mask index: Size-byte elements into W-byte words (0x80: zero byte)
+		template <std::size_t Size, std::size_t W, bool Little>
+		constexpr uchar unpack_index(std::size_t i)
+		{
+			return i % W >= Size ? 0x80 : static_cast<uchar>(i / W * Size + (Little ? i % W : Size - 1 - i % W));
+		}
+
+		template <std::size_t Size, std::size_t W, bool Little, std::size_t... I>
+		inline const uchar* unpack_mask(std::index_sequence<I...>)
+		{
+			alignas(16) static const uchar mask[]{unpack_index<Size, W, Little>(I)...};
+			return mask;
+		}
+
+		// Unpack n packed integers to native T (scalar, also used for tails)
+		template <std::size_t Bits, typename T, bool Native>
+		inline void unpack_n_generic(uchar* dst, const uchar* src, std::size_t n)
+		{
+			using type = endian_int<Bits, std::is_signed<T>::value, Native>;
+
+			for (std::size_t i = 0; i < n; i++, dst += sizeof(T), src += Bits / 8)
+			{
+				type value;
+				std::memcpy(&value, src, sizeof(type));
+				const T result = static_cast<T>(value.get());
+				std::memcpy(dst, &result, sizeof(T));
+			}
+		}
+
+#if defined(ENDIAN_X86)
+		template <std::size_t Bits, typename T, bool Native>
+		ENDIAN_TARGET("ssse3") inline void unpack_n_ssse3(uchar* dst, const uchar* src, std::size_t n)
+		{
+			constexpr std::size_t size = Bits / 8;
+			constexpr std::size_t step = 16 / sizeof(T);
+			constexpr bool extend = std::is_signed<T>::value && Bits < sizeof(T) * 8;
+
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(unpack_mask<size, sizeof(T), Native>(std::make_index_sequence<16>())));
+			const __m128i sign = sizeof(T) == 4 ? _mm_set1_epi32(static_cast<int>(std::uint32_t{1} << (Bits - 1) % 32)) : _mm_set1_epi64x(static_cast<long long>(std::uint64_t{1} << (Bits - 1)));
+
+			std::size_t i = 0;
+
+			// Each step reads 16 bytes (not only step * size)
+			for (const std::size_t bytes = n * size; i * size + 16 <= bytes; i += step)
+			{
+				__m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * size)), mask);
+
+				if (extend)
+					v = sizeof(T) == 4 ? _mm_sub_epi32(_mm_xor_si128(v, sign), sign) : _mm_sub_epi64(_mm_xor_si128(v, sign), sign);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * sizeof(T)), v);
+			}
+
+			unpack_n_generic<Bits, T, Native>(dst + i * sizeof(T), src + i * size, n - i);
+		}
+#elif defined(ENDIAN_NEON) && defined(__aarch64__) && !defined(__BIG_ENDIAN__)
+		// Sign extension of Bits-wide values in 4 or 8-byte lanes (shift left + arithmetic shift right), 0: none
+		template <std::size_t Bits>
+		inline uint8x16_t unpack_extend_neon(uint8x16_t v, std::integral_constant<std::size_t, 0>)
+		{
+			return v;
+		}
+
+		template <std::size_t Bits>
+		inline uint8x16_t unpack_extend_neon(uint8x16_t v, std::integral_constant<std::size_t, 4>)
+		{
+			return vreinterpretq_u8_s32(vshrq_n_s32(vshlq_n_s32(vreinterpretq_s32_u8(v), 32 - Bits), 32 - Bits));
+		}
+
+		template <std::size_t Bits>
+		inline uint8x16_t unpack_extend_neon(uint8x16_t v, std::integral_constant<std::size_t, 8>)
+		{
+			return vreinterpretq_u8_s64(vshrq_n_s64(vshlq_n_s64(vreinterpretq_s64_u8(v), 64 - Bits), 64 - Bits));
+		}
+
+		template <std::size_t Bits, typename T, bool Native>
+		inline void unpack_n_neon(uchar* dst, const uchar* src, std::size_t n)
+		{
+			constexpr std::size_t size = Bits / 8;
+			constexpr std::size_t step = 16 / sizeof(T);
+			constexpr bool extend = std::is_signed<T>::value && Bits < sizeof(T) * 8;
+
+			const uint8x16_t mask = vld1q_u8(unpack_mask<size, sizeof(T), Native>(std::make_index_sequence<16>()));
+
+			std::size_t i = 0;
+
+			for (const std::size_t bytes = n * size; i * size + 16 <= bytes; i += step)
+			{
+				uint8x16_t v = vqtbl1q_u8(vld1q_u8(src + i * size), mask);
+
+				// Shift immediates must be in range, so full-width lanes aren't instantiated
+				v = unpack_extend_neon<Bits>(v, std::integral_constant<std::size_t, extend ? sizeof(T) : 0>());
+
+				vst1q_u8(dst + i * sizeof(T), v);
+			}
+
+			unpack_n_generic<Bits, T, Native>(dst + i * sizeof(T), src + i * size, n - i);
+		}
+#endif
+
+		template <std::size_t Bits, typename T, bool Native>
+		inline void unpack_n(void* dst, const void* src, std::size_t n)
+		{
+			static_assert(Bits % 8 == 0 && Bits >= 8 && Bits <= sizeof(T) * 8, "unpack_n<>: invalid size");
+			static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8), "unpack_n<>: invalid type");
+
+			static const bswap_n_func func = []() -> bswap_n_func {
+#if defined(ENDIAN_X86_DISPATCH)
+				__builtin_cpu_init();
+
+				if (__builtin_cpu_supports("ssse3"))
+					return unpack_n_ssse3<Bits, T, Native>;
+#elif defined(ENDIAN_X86) && (defined(__SSSE3__) || defined(__AVX__))
+				return unpack_n_ssse3<Bits, T, Native>;
+#elif defined(ENDIAN_NEON) && defined(__aarch64__) && !defined(__BIG_ENDIAN__)
+				return unpack_n_neon<Bits, T, Native>;
+#endif
+				return unpack_n_generic<Bits, T, Native>;
+			}();
+
+			func(static_cast<uchar*>(dst), static_cast<const uchar*>(src), n);
+		}
+	}
+
+	// Unpack n packed `Bits`-wide LE integers (e.g. 24-bit samples) into native int32_t/int64_t/uint32_t/uint64_t array.
+	// Sign extension is performed if T is signed.
+	template <std::size_t Bits, typename T>
+	void le_unpack_n(T* dst, const void* src, std::size_t n)
+	{
+		detail::unpack_n<Bits, T, endian::native == endian::little>(dst, src, n);
+	}
+
+	// Same for BE integers
+	template <std::size_t Bits, typename T>
+	void be_unpack_n(T* dst, const void* src, std::size_t n)
+	{
+		detail::unpack_n<Bits, T, endian::native == endian::big>(dst, src, n);
+	}
+
+	namespace detail
+	{
+		template <std::size_t Bits, bool Signed, bool Native>
+		struct record_field<endian_int<Bits, Signed, Native>>
+		{
+			static constexpr std::size_t swap = Native ? 0 : Bits / 8;
+			static constexpr std::size_t count = 1;
+			static constexpr std::size_t stride = Bits / 8;
+		};
+
+		template <typename T, typename = void>
+		struct has_endian_fields : std::false_type
+		{
+		};
+
+		template <typename T>
+		struct has_endian_fields<T, decltype(static_cast<void>(sizeof(typename T::endian_fields)))> : std::true_type
+		{
+		};
+
+		// Field equivalent for wire byte order `Order`: endian_base<..., true> if bytes are already in wire order,
+		// endian_base<..., false> (swapped) otherwise; void if unsupported
+		template <typename F, endian Order, typename = void>
+		struct wire_field
+		{
+			using type = void;
+		};
+
+		template <typename T, std::size_t A, bool Native, endian Order>
+		struct wire_field<endian_base<T, A, Native>, Order>
+		{
+			using type = endian_base<T, A, sizeof(T) == 1 || Native == (Order == endian::native)>;
+		};
+
+		template <std::size_t Bits, bool Signed, bool Native, endian Order>
+		struct wire_field<endian_int<Bits, Signed, Native>, Order>
+		{
+			using type = endian_int<Bits, Signed, Bits == 8 || Native == (Order == endian::native)>;
+		};
+
+		template <typename T, typename Base, bool Native, endian Order>
+		struct wire_field<endian_ptr<T, Base, Native>, Order>
+		{
+			using type = endian_base<std::uint32_t, alignof(std::uint32_t), Native == (Order == endian::native)>;
+		};
+
+		// Native arithmetic and enum types are in native byte order
+		template <typename T, endian Order>
+		struct wire_field<T, Order, std::enable_if_t<has_endianness<T>::value>>
+		{
+			using type = endian_base<T, alignof(T), sizeof(T) == 1 || Order == endian::native>;
+		};
+
+		template <typename F, std::size_t N, endian Order>
+		struct wire_field<F[N], Order, std::enable_if_t<!std::is_void<typename wire_field<F, Order>::type>::value>>
+		{
+			using type = typename wire_field<F, Order>::type[N];
+		};
+
+		template <typename F, endian Order>
+		struct wire_record;
+
+		template <typename... Fields, endian Order>
+		struct wire_record<endian_record<Fields...>, Order>
+		{
+			static constexpr bool supported()
+			{
+				const bool valid[]{!std::is_void<typename wire_field<Fields, Order>::type>::value...};
+
+				for (bool v : valid)
+				{
+					if (!v)
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			static_assert(supported(), "serialize<>: unsupported field (define endian_fields or make nested record wire ready)");
+
+			using type = endian_record<typename wire_field<Fields, Order>::type...>;
+		};
+
+		template <typename F>
+		struct wire_ready_field : std::integral_constant<bool, record_field<F>::swap == 0>
+		{
+		};
+
+		template <>
+		struct wire_ready_field<void> : std::false_type
+		{
+		};
+
+		template <typename F, endian Order>
+		struct wire_ready_record : std::false_type
+		{
+		};
+
+		// All fields in wire order and no padding
+		template <typename... Fields, endian Order>
+		struct wire_ready_record<endian_record<Fields...>, Order>
+		{
+			static constexpr bool check()
+			{
+				const bool ready[]{wire_ready_field<typename wire_field<Fields, Order>::type>::value...};
+				const std::size_t size[]{sizeof(Fields)...};
+
+				std::size_t total = 0;
+
+				for (std::size_t i = 0; i < sizeof...(Fields); i++)
+				{
+					if (!ready[i])
+					{
+						return false;
+					}
+
+					total += size[i];
+				}
+
+				return total == endian_record<Fields...>::size;
+			}
+
+			static constexpr bool value = check();
+		};
+
+		// Nested records are supported if their layout is already in wire order
+		template <typename T, endian Order>
+		struct wire_field<T, Order, std::enable_if_t<has_endian_fields<T>::value>>
+		{
+			using type = std::conditional_t<wire_ready_record<typename T::endian_fields, Order>::value && sizeof(T) == T::endian_fields::size, T, void>;
+		};
+
+		// Field list of T: T::endian_fields, or T itself
+		template <typename T, typename = void>
+		struct wire_fields
+		{
+			using type = endian_record<T>;
+		};
+
+		template <typename T>
+		struct wire_fields<T, std::enable_if_t<has_endian_fields<T>::value>>
+		{
+			static_assert(T::endian_fields::size == sizeof(T), "endian_fields: layout mismatch");
+
+			using type = typename T::endian_fields;
+		};
+	}
+
+	// Object representation of T is already in wire byte order `Order` (serialization is memcpy).
+	// Structures describe their layout with member type `endian_fields` = std::endian_record<member types...>.
+	template <typename T, endian Order>
+	struct is_wire_ready : std::integral_constant<bool, std::is_trivially_copyable<T>::value && detail::wire_ready_record<typename detail::wire_fields<T>::type, Order>::value>
+	{
+	};
+
+	template <typename T>
+	using is_le_wire_ready = is_wire_ready<T, endian::little>;
+
+	template <typename T>
+	using is_be_wire_ready = is_wire_ready<T, endian::big>;
+
+	namespace detail
+	{
+		template <typename T, endian Order>
+		struct wire_conversion
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "serialize<>: invalid type");
+
+			using record = typename wire_record<typename wire_fields<T>::type, Order>::type;
+
+			// memcpy, then byteswap fields not in wire order (in place)
+			static void copy_n(void* dst, const void* src, std::size_t n)
+			{
+				if (dst != src)
+				{
+					std::memcpy(dst, src, n * sizeof(T));
+				}
+
+				if (!is_wire_ready<T, Order>::value)
+				{
+					record::convert_n(dst, dst, n);
+				}
+			}
+		};
+	}
+
+	// Write n objects in the wire byte order (memcpy if is_wire_ready, record conversion otherwise)
+	template <endian Order, typename T>
+	void serialize_n(void* dst, const T* src, std::size_t n)
+	{
+		detail::wire_conversion<T, Order>::copy_n(dst, src, n);
+	}
+
+	// Read n objects from the wire byte order
+	template <endian Order, typename T>
+	void deserialize_n(T* dst, const void* src, std::size_t n)
+	{
+		detail::wire_conversion<T, Order>::copy_n(dst, src, n);
+	}
+
+	template <endian Order, typename T>
+	void serialize(void* dst, const T& value)
+	{
+		detail::wire_conversion<T, Order>::copy_n(dst, &value, 1);
+	}
+
+	template <endian Order, typename T>
+	T deserialize(const void* src)
+	{
+		T result;
+		detail::wire_conversion<T, Order>::copy_n(&result, src, 1);
+		return result;
+	}
+
+	// Zero-copy read: view wire data as T (requires is_wire_ready, src must be suitably aligned for T)
+	template <endian Order, typename T>
+	const T* wire_cast(const void* src)
+	{
+		static_assert(is_wire_ready<T, Order>::value, "wire_cast<>: type is not wire ready");
+		return static_cast<const T*>(src);
+	}
+
+	template <endian Order, typename T>
+	T* wire_cast(void* src)
+	{
+		static_assert(is_wire_ready<T, Order>::value, "wire_cast<>: type is not wire ready");
+		return static_cast<T*>(src);
+	}
+
+	namespace detail
+	{
+		// Delta decode (prefix sum) with optional byteswap, returns the last value (scalar, also used for tails)
+		template <std::size_t Size, bool Swap, typename U = typename uint_of_size<Size>::type>
+		inline U delta_decode_generic(uchar* dst, const uchar* src, std::size_t n, U acc)
+		{
+			using buf = endian_buffer<U, Size, Size>;
+
+			for (std::size_t i = 0; i < n; i++, dst += Size, src += Size)
+			{
+				U value;
+				std::memcpy(&value, src, Size);
+				acc += Swap ? buf::swap(value) : value;
+				std::memcpy(dst, &acc, Size);
+			}
+
+			return acc;
+		}
+
+		// Delta encode with optional byteswap, returns the last value
+		template <std::size_t Size, bool Swap, typename U = typename uint_of_size<Size>::type>
+		inline U delta_encode_generic(uchar* dst, const uchar* src, std::size_t n, U prev)
+		{
+			using buf = endian_buffer<U, Size, Size>;
+
+			for (std::size_t i = 0; i < n; i++, dst += Size, src += Size)
+			{
+				U value;
+				std::memcpy(&value, src, Size);
+				const U delta = static_cast<U>(value - prev);
+				const U result = Swap ? buf::swap(delta) : delta;
+				prev = value;
+				std::memcpy(dst, &result, Size);
+			}
+
+			return prev;
+		}
+
+#if defined(ENDIAN_X86)
+		ENDIAN_TARGET("ssse3") inline __m128i add_n(__m128i a, __m128i b, std::integral_constant<std::size_t, 2>)
+		{
+			return _mm_add_epi16(a, b);
+		}
+
+		ENDIAN_TARGET("ssse3") inline __m128i add_n(__m128i a, __m128i b, std::integral_constant<std::size_t, 4>)
+		{
+			return _mm_add_epi32(a, b);
+		}
+
+		ENDIAN_TARGET("ssse3") inline __m128i add_n(__m128i a, __m128i b, std::integral_constant<std::size_t, 8>)
+		{
+			return _mm_add_epi64(a, b);
+		}
+
+		ENDIAN_TARGET("ssse3") inline __m128i sub_n(__m128i a, __m128i b, std::integral_constant<std::size_t, 2>)
+		{
+			return _mm_sub_epi16(a, b);
+		}
+
+		ENDIAN_TARGET("ssse3") inline __m128i sub_n(__m128i a, __m128i b, std::integral_constant<std::size_t, 4>)
+		{
+			return _mm_sub_epi32(a, b);
+		}
+
+		ENDIAN_TARGET("ssse3") inline __m128i sub_n(__m128i a, __m128i b, std::integral_constant<std::size_t, 8>)
+		{
+			return _mm_sub_epi64(a, b);
+		}
+
+		// Vector with all elements set to value
+		template <std::size_t Size, typename U>
+		ENDIAN_TARGET("ssse3") inline __m128i broadcast_n(U value)
+		{
+			uchar bytes[16];
+
+			for (std::size_t i = 0; i < 16; i += Size)
+			{
+				std::memcpy(bytes + i, &value, Size);
+			}
+
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+		}
+
+		// In-register prefix sum: one add per doubling step, previous block sum is broadcast as carry
+		template <std::size_t Size, bool Swap, typename U = typename uint_of_size<Size>::type>
+		ENDIAN_TARGET("ssse3") inline U delta_decode_ssse3(uchar* dst, const uchar* src, std::size_t n, U acc)
+		{
+			using size = std::integral_constant<std::size_t, Size>;
+
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(bswap_mask<Swap ? Size : 1>()));
+			const __m128i last = broadcast_n<Size>(static_cast<U>(0x0f0e0d0c0b0a0908ull >> (64 - Size * 8)));
+			__m128i carry = broadcast_n<Size>(acc);
+
+			std::size_t i = 0;
+
+			for (const std::size_t bytes = n * Size; i + 16 <= bytes; i += 16)
+			{
+				__m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), mask);
+
+				if (Size <= 8)
+					v = add_n(v, _mm_slli_si128(v, 8), size());
+				if (Size <= 4)
+					v = add_n(v, _mm_slli_si128(v, 4), size());
+				if (Size <= 2)
+					v = add_n(v, _mm_slli_si128(v, 2), size());
+
+				v = add_n(v, carry, size());
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+				carry = _mm_shuffle_epi8(v, last);
+			}
+
+			std::memcpy(&acc, reinterpret_cast<const uchar*>(&carry), Size);
+			return delta_decode_generic<Size, Swap>(dst + i, src + i, n - i / Size, acc);
+		}
+
+		template <std::size_t Size, bool Swap, typename U = typename uint_of_size<Size>::type>
+		ENDIAN_TARGET("ssse3") inline U delta_encode_ssse3(uchar* dst, const uchar* src, std::size_t n, U prev)
+		{
+			using size = std::integral_constant<std::size_t, Size>;
+
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(bswap_mask<Swap ? Size : 1>()));
+			__m128i last = broadcast_n<Size>(prev);
+
+			std::size_t i = 0;
+
+			for (const std::size_t bytes = n * Size; i + 16 <= bytes; i += 16)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				const __m128i d = sub_n(v, _mm_alignr_epi8(v, last, 16 - Size), size());
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(d, mask));
+				last = v;
+			}
+
+			// Not from src (may be overwritten)
+			std::memcpy(&prev, reinterpret_cast<const uchar*>(&last) + 16 - Size, Size);
+
+			return delta_encode_generic<Size, Swap>(dst + i, src + i, n - i / Size, prev);
+		}
+#endif
+
+		template <std::size_t Size, bool Swap, typename U = typename uint_of_size<Size>::type>
+		inline U delta_decode_n(void* dst, const void* src, std::size_t n, U init)
+		{
+			using func_t = U (*)(uchar*, const uchar*, std::size_t, U);
+
+			static const func_t func = []() -> func_t {
+#if defined(ENDIAN_X86_DISPATCH)
+				__builtin_cpu_init();
+
+				if (__builtin_cpu_supports("ssse3"))
+					return delta_decode_ssse3<Size, Swap>;
+#elif defined(ENDIAN_X86) && (defined(__SSSE3__) || defined(__AVX__))
+				return delta_decode_ssse3<Size, Swap>;
+#endif
+				return delta_decode_generic<Size, Swap>;
+			}();
+
+			return func(static_cast<uchar*>(dst), static_cast<const uchar*>(src), n, init);
+		}
+
+		template <std::size_t Size, bool Swap, typename U = typename uint_of_size<Size>::type>
+		inline U delta_encode_n(void* dst, const void* src, std::size_t n, U init)
+		{
+			using func_t = U (*)(uchar*, const uchar*, std::size_t, U);
+
+			static const func_t func = []() -> func_t {
+#if defined(ENDIAN_X86_DISPATCH)
+				__builtin_cpu_init();
+
+				if (__builtin_cpu_supports("ssse3"))
+					return delta_encode_ssse3<Size, Swap>;
+#elif defined(ENDIAN_X86) && (defined(__SSSE3__) || defined(__AVX__))
+				return delta_encode_ssse3<Size, Swap>;
+#endif
+				return delta_encode_generic<Size, Swap>;
+			}();
+
+			return func(static_cast<uchar*>(dst), static_cast<const uchar*>(src), n, init);
+		}
+
+		template <typename T>
+		using delta_uint = typename uint_of_size<sizeof(T)>::type;
+	}
+
+	// Load n LE delta-encoded integers and compute prefix sum starting from init (wrapping arithmetic, dst == src is allowed).
+	// Returns the last value (init for the next part of the array).
+	template <typename T>
+	T le_delta_decode_n(T* dst, const void* src, std::size_t n, T init = 0)
+	{
+		static_assert(std::is_integral<T>::value && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8), "le_delta_decode_n<>: invalid type");
+		return static_cast<T>(detail::delta_decode_n<sizeof(T), endian::native != endian::little>(dst, src, n, static_cast<detail::delta_uint<T>>(init)));
+	}
+
+	// Store differences of n native integers (first one relative to init) as LE, returns src[n - 1] (or init)
+	template <typename T>
+	T le_delta_encode_n(void* dst, const T* src, std::size_t n, T init = 0)
+	{
+		static_assert(std::is_integral<T>::value && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8), "le_delta_encode_n<>: invalid type");
+		return static_cast<T>(detail::delta_encode_n<sizeof(T), endian::native != endian::little>(dst, src, n, static_cast<detail::delta_uint<T>>(init)));
+	}
+
+	// Same for BE
+	template <typename T>
+	T be_delta_decode_n(T* dst, const void* src, std::size_t n, T init = 0)
+	{
+		static_assert(std::is_integral<T>::value && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8), "be_delta_decode_n<>: invalid type");
+		return static_cast<T>(detail::delta_decode_n<sizeof(T), endian::native != endian::big>(dst, src, n, static_cast<detail::delta_uint<T>>(init)));
+	}
+
+	template <typename T>
+	T be_delta_encode_n(void* dst, const T* src, std::size_t n, T init = 0)
+	{
+		static_assert(std::is_integral<T>::value && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8), "be_delta_encode_n<>: invalid type");
+		return static_cast<T>(detail::delta_encode_n<sizeof(T), endian::native != endian::big>(dst, src, n, static_cast<detail::delta_uint<T>>(init)));
+	}
+
+	namespace detail
+	{
+		// One's complement sum of 16-bit words in memory order (byte order independent, RFC 1071), not folded
+		inline std::uint64_t ones_sum_generic(const uchar* src, std::size_t size, std::uint64_t sum)
+		{
+			for (; size >= 4; src += 4, size -= 4)
+			{
+				std::uint32_t value;
+				std::memcpy(&value, src, 4);
+				sum += value;
+			}
+
+			if (size >= 2)
+			{
+				std::uint16_t value;
+				std::memcpy(&value, src, 2);
+				sum += value;
+				src += 2;
+				size -= 2;
+			}
+
+			if (size)
+			{
+				// Odd byte is padded with zero
+				const uchar bytes[2]{src[0], 0};
+				std::uint16_t value;
+				std::memcpy(&value, bytes, 2);
+				sum += value;
+			}
+
+			return sum;
+		}
+
+		inline std::uint16_t ones_fold(std::uint64_t sum)
+		{
+			while (sum >> 16)
+			{
+				sum = (sum & 0xffff) + (sum >> 16);
+			}
+
+			return static_cast<std::uint16_t>(sum);
+		}
+
+#if defined(ENDIAN_X86)
+		ENDIAN_TARGET("sse2") inline std::uint64_t ones_sum_sse2(const uchar* src, std::size_t size, std::uint64_t sum)
+		{
+			const __m128i lo = _mm_set1_epi32(0xffff);
+
+			while (size >= 16)
+			{
+				// 32-bit lanes can't overflow within one block (2 * 16383 additions of 16-bit values)
+				__m128i acc = _mm_setzero_si128();
+
+				for (std::size_t i = 0; i < 16383 && size >= 16; i++, src += 16, size -= 16)
+				{
+					const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+					acc = _mm_add_epi32(acc, _mm_and_si128(v, lo));
+					acc = _mm_add_epi32(acc, _mm_srli_epi32(v, 16));
+				}
+
+				std::uint32_t lanes[4];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+				sum += std::uint64_t{lanes[0]} + lanes[1] + lanes[2] + lanes[3];
+			}
+
+			return ones_sum_generic(src, size, sum);
+		}
+
+		ENDIAN_TARGET("avx2") inline std::uint64_t ones_sum_avx2(const uchar* src, std::size_t size, std::uint64_t sum)
+		{
+			const __m256i lo = _mm256_set1_epi32(0xffff);
+
+			while (size >= 64)
+			{
+				__m256i acc0 = _mm256_setzero_si256();
+				__m256i acc1 = _mm256_setzero_si256();
+
+				for (std::size_t i = 0; i < 16383 && size >= 64; i++, src += 64, size -= 64)
+				{
+					const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+					const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+					acc0 = _mm256_add_epi32(acc0, _mm256_add_epi32(_mm256_and_si256(v0, lo), _mm256_srli_epi32(v0, 16)));
+					acc1 = _mm256_add_epi32(acc1, _mm256_add_epi32(_mm256_and_si256(v1, lo), _mm256_srli_epi32(v1, 16)));
+				}
+
+				std::uint32_t lanes[16];
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc0);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes + 8), acc1);
+
+				for (std::uint32_t lane : lanes)
+				{
+					sum += lane;
+				}
+			}
+
+			return ones_sum_sse2(src, size, sum);
+		}
+#endif
+
+		inline std::uint64_t ones_sum(const void* src, std::size_t size, std::uint64_t sum)
+		{
+			using func_t = std::uint64_t (*)(const uchar*, std::size_t, std::uint64_t);
+
+			static const func_t func = []() -> func_t {
+#if defined(ENDIAN_X86_DISPATCH)
+				__builtin_cpu_init();
+
+				if (__builtin_cpu_supports("avx2"))
+					return ones_sum_avx2;
+				if (__builtin_cpu_supports("sse2"))
+					return ones_sum_sse2;
+#elif defined(ENDIAN_X86) && defined(__AVX2__)
+				return ones_sum_avx2;
+#elif defined(ENDIAN_X86) && (defined(__SSE2__) || defined(_M_X64))
+				return ones_sum_sse2;
+#endif
+				return ones_sum_generic;
+			}();
+
+			return func(static_cast<const uchar*>(src), size, sum);
+		}
+
+		// Storage of BE uint16_t as native integer
+		inline std::uint16_t be_raw16(std::uint16_t value)
+		{
+			std::uint16_t result;
+			be_store(&result, value);
+			return result;
+		}
+	}
+
+	// Internet checksum (RFC 1071) of BE data, init is partial sum (e.g. of pseudo-header). Returns native value.
+	// The sum is computed on storage without byteswap; only the result is converted.
+	inline std::uint16_t be_checksum16(const void* data, std::size_t size, std::uint16_t init = 0)
+	{
+		const std::uint16_t raw = static_cast<std::uint16_t>(~detail::ones_fold(detail::ones_sum(data, size, detail::be_raw16(init))));
+		return be_load<std::uint16_t>(&raw);
+	}
+
+#if defined(__cpp_lib_span)
+	template <typename T, std::size_t N>
+	std::uint16_t be_checksum16(std::span<T, N> data, std::uint16_t init = 0)
+	{
+		return be_checksum16(data.data(), data.size_bytes(), init);
+	}
+#endif
+
+	// Incremental checksum update (RFC 1624) after changing BE field from old_value to new_value (field size must be even).
+	// Works on storage directly: HC' = ~(~HC + ~m + m')
+	template <std::size_t A, typename T, std::size_t A2, std::size_t A3>
+	void be_checksum16_update(be_t<std::uint16_t, A>& checksum, const be_t<T, A2>& old_value, const be_t<T, A3>& new_value)
+	{
+		static_assert(sizeof(T) % 2 == 0, "be_checksum16_update<>: invalid field size");
+
+		std::uint16_t raw;
+		std::memcpy(&raw, reinterpret_cast<const detail::uchar*>(&checksum), 2);
+		std::uint64_t sum = static_cast<std::uint16_t>(~raw);
+
+		for (std::size_t i = 0; i < sizeof(T); i += 2)
+		{
+			std::uint16_t m, m2;
+			std::memcpy(&m, reinterpret_cast<const detail::uchar*>(&old_value) + i, 2);
+			std::memcpy(&m2, reinterpret_cast<const detail::uchar*>(&new_value) + i, 2);
+			sum += static_cast<std::uint16_t>(~m);
+			sum += m2;
+		}
+
+		raw = static_cast<std::uint16_t>(~detail::ones_fold(sum));
+		std::memcpy(reinterpret_cast<detail::uchar*>(&checksum), &raw, 2);
+	}
+
+	// Same as above, assign the new value to the field and update checksum
+	template <std::size_t A, typename T, std::size_t A2>
+	void be_checksum16_assign(be_t<std::uint16_t, A>& checksum, be_t<T, A2>& field, const T& value)
+	{
+		const be_t<T, A2> old_value = field;
+		field = value;
+		be_checksum16_update(checksum, old_value, field);
+	}
+
+	namespace detail
+	{
+		// CRC32C (Castagnoli, reflected) table entry
+		constexpr std::uint32_t crc32c_entry(std::uint32_t value, int bits = 8)
+		{
+			return bits == 0 ? value : crc32c_entry(value & 1 ? (value >> 1) ^ 0x82f63b78 : value >> 1, bits - 1);
+		}
+
+		template <std::size_t... I>
+		inline const std::uint32_t* crc32c_table(std::index_sequence<I...>)
+		{
+			alignas(64) static const std::uint32_t table[]{crc32c_entry(I)...};
+			return table;
+		}
+
+		// Element value (as unsigned integer) from storage
+		template <std::size_t Size, bool Native, typename U = typename uint_of_size<Size>::type>
+		ENDIAN_FORCEINLINE U load_value(const uchar* src)
+		{
+			using buf = endian_buffer<U, Size, 1>;
+			return Native ? buf::get_ne(*reinterpret_cast<const buf*>(src)) : buf::get_re(*reinterpret_cast<const buf*>(src));
+		}
+
+		// CRC32C of element values as little-endian bytes (table-driven fallback)
+		template <std::size_t Size, bool Native>
+		inline std::uint32_t crc32c_generic(const uchar* src, std::size_t n, std::uint32_t crc)
+		{
+			const std::uint32_t* table = crc32c_table(std::make_index_sequence<256>());
+
+			for (std::size_t i = 0; i < n; i++, src += Size)
+			{
+				const auto value = load_value<Size, Native>(src);
+
+				for (std::size_t j = 0; j < Size; j++)
+				{
+					crc = table[(crc ^ static_cast<std::uint32_t>(value >> (j * 8))) & 0xff] ^ (crc >> 8);
+				}
+			}
+
+			return crc;
+		}
+
+#if defined(ENDIAN_X86)
+		ENDIAN_TARGET("sse4.2") inline std::uint32_t crc32c_step(std::uint32_t crc, std::uint8_t value)
+		{
+			return _mm_crc32_u8(crc, value);
+		}
+
+		ENDIAN_TARGET("sse4.2") inline std::uint32_t crc32c_step(std::uint32_t crc, std::uint16_t value)
+		{
+			return _mm_crc32_u16(crc, value);
+		}
+
+		ENDIAN_TARGET("sse4.2") inline std::uint32_t crc32c_step(std::uint32_t crc, std::uint32_t value)
+		{
+			return _mm_crc32_u32(crc, value);
+		}
+
+		ENDIAN_TARGET("sse4.2") inline std::uint32_t crc32c_step(std::uint32_t crc, std::uint64_t value)
+		{
+#if defined(__x86_64__) || defined(_M_X64)
+			return static_cast<std::uint32_t>(_mm_crc32_u64(crc, value));
+#else
+			return _mm_crc32_u32(_mm_crc32_u32(crc, static_cast<std::uint32_t>(value)), static_cast<std::uint32_t>(value >> 32));
+#endif
+		}
+
+		// Hardware CRC32C, byteswap (if necessary) is performed on loaded value
+		template <std::size_t Size, bool Native>
+		ENDIAN_TARGET("sse4.2") inline std::uint32_t crc32c_sse42(const uchar* src, std::size_t n, std::uint32_t crc)
+		{
+			for (std::size_t i = 0; i < n; i++, src += Size)
+			{
+				crc = crc32c_step(crc, load_value<Size, Native>(src));
+			}
+
+			return crc;
+		}
+#elif defined(__ARM_FEATURE_CRC32)
+		inline std::uint32_t crc32c_step(std::uint32_t crc, std::uint8_t value)
+		{
+			return __crc32cb(crc, value);
+		}
+
+		inline std::uint32_t crc32c_step(std::uint32_t crc, std::uint16_t value)
+		{
+			return __crc32ch(crc, value);
+		}
+
+		inline std::uint32_t crc32c_step(std::uint32_t crc, std::uint32_t value)
+		{
+			return __crc32cw(crc, value);
+		}
+
+		inline std::uint32_t crc32c_step(std::uint32_t crc, std::uint64_t value)
+		{
+			return __crc32cd(crc, value);
+		}
+
+		template <std::size_t Size, bool Native>
+		inline std::uint32_t crc32c_arm(const uchar* src, std::size_t n, std::uint32_t crc)
+		{
+			for (std::size_t i = 0; i < n; i++, src += Size)
+			{
+				crc = crc32c_step(crc, load_value<Size, Native>(src));
+			}
+
+			return crc;
+		}
+#endif
+
+		template <std::size_t Size, bool Native>
+		inline std::uint32_t crc32c_n(const void* src, std::size_t n, std::uint32_t crc)
+		{
+			using func_t = std::uint32_t (*)(const uchar*, std::size_t, std::uint32_t);
+
+			static const func_t func = []() -> func_t {
+#if defined(ENDIAN_X86_DISPATCH)
+				__builtin_cpu_init();
+
+				if (__builtin_cpu_supports("sse4.2"))
+					return crc32c_sse42<Size, Native>;
+#elif defined(ENDIAN_X86) && defined(__SSE4_2__)
+				return crc32c_sse42<Size, Native>;
+#elif !defined(ENDIAN_X86) && defined(__ARM_FEATURE_CRC32)
+				return crc32c_arm<Size, Native>;
+#endif
+				return crc32c_generic<Size, Native>;
+			}();
+
+			return ~func(static_cast<const uchar*>(src), n, ~crc);
+		}
+
+		constexpr std::uint64_t xxh_p1 = 11400714785074694791ull;
+		constexpr std::uint64_t xxh_p2 = 14029467366897019727ull;
+		constexpr std::uint64_t xxh_p3 = 1609587929392839161ull;
+		constexpr std::uint64_t xxh_p4 = 9650029242287828579ull;
+		constexpr std::uint64_t xxh_p5 = 2870177450012600261ull;
+
+		constexpr std::uint64_t rotl64(std::uint64_t value, int shift)
+		{
+			return value << shift | value >> (64 - shift);
+		}
+
+		constexpr std::uint64_t xxh64_round(std::uint64_t acc, std::uint64_t input)
+		{
+			return rotl64(acc + input * xxh_p2, 31) * xxh_p1;
+		}
+
+		constexpr std::uint64_t xxh64_merge(std::uint64_t acc, std::uint64_t value)
+		{
+			return (acc ^ xxh64_round(0, value)) * xxh_p1 + xxh_p4;
+		}
+
+		// Read Bytes of little-endian stream of element values at src (Bytes is multiple of Size or less than Size)
+		template <std::size_t Bytes, std::size_t Size, bool Native>
+		ENDIAN_FORCEINLINE std::uint64_t xxh64_read(const uchar* src)
+		{
+			std::uint64_t result = 0;
+
+			for (std::size_t i = 0; i < Bytes; i += Size, src += Size)
+			{
+				result |= static_cast<std::uint64_t>(load_value<Size, Native>(src)) << (i * 8);
+			}
+
+			return result;
+		}
+
+		// XXH64 of element values as little-endian bytes
+		template <std::size_t Size, bool Native>
+		inline std::uint64_t xxh64_n(const uchar* src, std::size_t n, std::uint64_t seed)
+		{
+			const std::size_t size = n * Size;
+			const uchar* const end = src + size;
+
+			std::uint64_t h;
+
+			if (size >= 32)
+			{
+				std::uint64_t v1 = seed + xxh_p1 + xxh_p2;
+				std::uint64_t v2 = seed + xxh_p2;
+				std::uint64_t v3 = seed;
+				std::uint64_t v4 = seed - xxh_p1;
+
+				for (; src + 32 <= end; src += 32)
+				{
+					v1 = xxh64_round(v1, xxh64_read<8, Size, Native>(src));
+					v2 = xxh64_round(v2, xxh64_read<8, Size, Native>(src + 8));
+					v3 = xxh64_round(v3, xxh64_read<8, Size, Native>(src + 16));
+					v4 = xxh64_round(v4, xxh64_read<8, Size, Native>(src + 24));
+				}
+
+				h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+				h = xxh64_merge(xxh64_merge(xxh64_merge(xxh64_merge(h, v1), v2), v3), v4);
+			}
+			else
+			{
+				h = seed + xxh_p5;
+			}
+
+			h += size;
+
+			for (; src + 8 <= end; src += 8)
+			{
+				h = rotl64(h ^ xxh64_round(0, xxh64_read<8, Size, Native>(src)), 27) * xxh_p1 + xxh_p4;
+			}
+
+			// Tails smaller than 8 bytes are only possible for Size < 8
+			for (; Size <= 4 && src + 4 <= end; src += 4)
+			{
+				h = rotl64(h ^ xxh64_read<4, Size, Native>(src) * xxh_p1, 23) * xxh_p2 + xxh_p3;
+			}
+
+			for (; src < end; src += Size)
+			{
+				const std::uint64_t value = load_value<Size, Native>(src);
+
+				for (std::size_t j = 0; j < Size; j++)
+				{
+					h = rotl64(h ^ (value >> (j * 8) & 0xff) * xxh_p5, 11) * xxh_p1;
+				}
+			}
+
+			h ^= h >> 33;
+			h *= xxh_p2;
+			h ^= h >> 29;
+			h *= xxh_p3;
+			h ^= h >> 32;
+			return h;
+		}
+	}
+
+	// CRC32C of n LE/BE values (the same as CRC32C of native little-endian array of them), crc: previous result.
+	// Uses CRC32 instructions (SSE4.2 or ARMv8) if available. Byteswap is fused into loads.
+	template <typename T, std::size_t A, bool Native>
+	std::uint32_t crc32c_n(const endian_base<T, A, Native>* data, std::size_t n, std::uint32_t crc = 0)
+	{
+		static_assert(sizeof(endian_base<T, A, Native>) == sizeof(T) && sizeof(T) <= 8, "crc32c_n<>: invalid type");
+		return detail::crc32c_n<sizeof(T), Native>(data, n, crc);
+	}
+
+	// XXH64 of n LE/BE values (the same as XXH64 of native little-endian array of them)
+	template <typename T, std::size_t A, bool Native>
+	std::uint64_t xxh64_n(const endian_base<T, A, Native>* data, std::size_t n, std::uint64_t seed = 0)
+	{
+		static_assert(sizeof(endian_base<T, A, Native>) == sizeof(T) && sizeof(T) <= 8, "xxh64_n<>: invalid type");
+		return detail::xxh64_n<sizeof(T), Native>(reinterpret_cast<const detail::uchar*>(data), n, seed);
+	}
+
+#if defined(__cpp_lib_span)
+	template <typename T, std::size_t A, bool Native>
+	std::uint32_t crc32c_n(std::span<const endian_base<T, A, Native>> data, std::uint32_t crc = 0)
+	{
+		return crc32c_n(data.data(), data.size(), crc);
+	}
+
+	template <typename T, std::size_t A, bool Native>
+	std::uint64_t xxh64_n(std::span<const endian_base<T, A, Native>> data, std::uint64_t seed = 0)
+	{
+		return xxh64_n(data.data(), data.size(), seed);
+	}
+#endif
+
+	// Hash of LE/BE integers and enums is computed from storage (without byteswap), other types are hashed by value
+	template <typename T, std::size_t A, bool Native>
+	struct hash<endian_base<T, A, Native>>
+	{
+		std::size_t operator()(const endian_base<T, A, Native>& value) const noexcept
+		{
+			return get(value, std::integral_constant<bool, (detail::is_integer<T>::value || std::is_enum<T>::value) && sizeof(T) <= 8>());
+		}
+
+	private:
+		static std::size_t get(const endian_base<T, A, Native>& value, std::true_type)
+		{
+			typename detail::uint_of_size<sizeof(T)>::type raw;
+			std::memcpy(&raw, reinterpret_cast<const detail::uchar*>(&value), sizeof(T));
+			return std::hash<decltype(raw)>()(raw);
+		}
+
+		static std::size_t get(const endian_base<T, A, Native>& value, std::false_type)
+		{
+			return std::hash<T>()(value.get());
+		}
+	};
+
+	namespace detail
+	{
+		// Key type for ordering (underlying type for enums)
+		template <typename T, bool = std::is_enum<T>::value>
+		struct sort_key
+		{
+			using type = T;
+		};
+
+		template <typename T>
+		struct sort_key<T, true>
+		{
+			using type = std::underlying_type_t<T>;
+		};
+
+		template <typename T>
+		using sort_key_t = typename sort_key<T>::type;
+
+		template <typename T>
+		using is_sortable = std::integral_constant<bool, detail::is_integer<sort_key_t<T>>::value || (std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8))>;
+
+		// Radix sort digit i (0: most significant) of key in storage (Big: stored as BE), order-preserving transform is applied
+		template <typename T, bool Big>
+		ENDIAN_FORCEINLINE uchar sort_digit(const uchar* key, std::size_t i)
+		{
+			using K = sort_key_t<T>;
+
+			const uchar value = key[Big ? i : sizeof(T) - 1 - i];
+
+			if (std::is_floating_point<K>::value)
+			{
+				const bool sign = key[Big ? 0 : sizeof(T) - 1] & 0x80;
+				return static_cast<uchar>(value ^ (sign ? 0xff : i == 0 ? 0x80 : 0));
+			}
+
+			if (std::is_signed<K>::value && i == 0)
+			{
+				return static_cast<uchar>(value ^ 0x80);
+			}
+
+			return value;
+		}
+
+		// LSD radix sort of n Size-byte elements by key at offset (stable)
+		template <typename T, bool Big, std::size_t Size>
+		void radix_sort_n(uchar* data, std::size_t n, std::size_t offset)
+		{
+			if (n < 2)
+			{
+				return;
+			}
+
+			// Histograms of all digits in one pass
+			std::vector<std::size_t> counts(sizeof(T) * 256);
+
+			for (std::size_t j = 0; j < n; j++)
+			{
+				for (std::size_t i = 0; i < sizeof(T); i++)
+				{
+					counts[i * 256 + sort_digit<T, Big>(data + j * Size + offset, i)]++;
+				}
+			}
+
+			std::vector<uchar> temp(n * Size);
+
+			uchar* src = data;
+			uchar* dst = temp.data();
+
+			for (std::size_t i = sizeof(T); i-- > 0;)
+			{
+				std::size_t* pos = counts.data() + i * 256;
+
+				// Skip digit if it's the same in all keys
+				if (pos[sort_digit<T, Big>(src + offset, i)] == n)
+				{
+					continue;
+				}
+
+				for (std::size_t d = 0, sum = 0; d < 256; d++)
+				{
+					const std::size_t count = pos[d];
+					pos[d] = sum;
+					sum += count;
+				}
+
+				for (std::size_t j = 0; j < n; j++)
+				{
+					const uchar* elem = src + j * Size;
+					std::memcpy(dst + pos[sort_digit<T, Big>(elem + offset, i)]++ * Size, elem, Size);
+				}
+
+				std::swap(src, dst);
+			}
+
+			if (src != data)
+			{
+				std::memcpy(data, src, n * Size);
+			}
+		}
+	}
+
+	// Order-preserving key: unsigned comparison (or memcmp) of result gives the same order as comparison of values.
+	// Signed integers: sign bit flipped; floating point: sign bit flipped if positive, all bits flipped if negative.
+	template <typename T>
+	ENDIAN_CONSTEXPR be_t<typename detail::uint_of_size<sizeof(T)>::type> to_sortable_be(const T& value)
+	{
+		static_assert(detail::is_sortable<T>::value, "to_sortable_be<>: invalid type");
+
+		using U = typename detail::uint_of_size<sizeof(T)>::type;
+		using K = detail::sort_key_t<T>;
+
+		constexpr U sign = U{1} << (sizeof(T) * 8 - 1);
+
+		const U bits = detail::bit_cast<U>(value);
+
+		if (std::is_floating_point<K>::value)
+		{
+			return static_cast<U>(bits ^ (bits & sign ? static_cast<U>(~U{0}) : sign));
+		}
+
+		return std::is_signed<K>::value ? static_cast<U>(bits ^ sign) : bits;
+	}
+
+	// Inverse of to_sortable_be
+	template <typename T, std::size_t A>
+	ENDIAN_CONSTEXPR T from_sortable_be(const be_t<typename detail::uint_of_size<sizeof(T)>::type, A>& key)
+	{
+		static_assert(detail::is_sortable<T>::value, "from_sortable_be<>: invalid type");
+
+		using U = typename detail::uint_of_size<sizeof(T)>::type;
+		using K = detail::sort_key_t<T>;
+
+		constexpr U sign = U{1} << (sizeof(T) * 8 - 1);
+
+		const U bits = key.get();
+
+		if (std::is_floating_point<K>::value)
+		{
+			return detail::bit_cast<T>(static_cast<U>(bits ^ (bits & sign ? sign : static_cast<U>(~U{0}))));
+		}
+
+		return detail::bit_cast<T>(std::is_signed<K>::value ? static_cast<U>(bits ^ sign) : bits);
+	}
+
+	// Sort array of LE/BE values (LSD radix sort reading digits from storage without byteswap, stable)
+	template <typename T, std::size_t A, bool Native>
+	void radix_sort(endian_base<T, A, Native>* data, std::size_t n)
+	{
+		static_assert(detail::is_sortable<T>::value, "radix_sort<>: invalid type");
+		detail::radix_sort_n<T, Native == (endian::native == endian::big), sizeof(endian_base<T, A, Native>)>(reinterpret_cast<detail::uchar*>(data), n, 0);
+	}
+
+	// Sort array of records by LE/BE key field
+	template <typename R, typename T, std::size_t A, bool Native>
+	void radix_sort(R* data, std::size_t n, endian_base<T, A, Native> R::*key)
+	{
+		static_assert(detail::is_sortable<T>::value, "radix_sort<>: invalid key type");
+		static_assert(std::is_trivially_copyable<R>::value, "radix_sort<>: invalid record type");
+
+		if (n == 0)
+		{
+			return;
+		}
+
+		const std::size_t offset = reinterpret_cast<const detail::uchar*>(&(data->*key)) - reinterpret_cast<const detail::uchar*>(data);
+		detail::radix_sort_n<T, Native == (endian::native == endian::big), sizeof(R)>(reinterpret_cast<detail::uchar*>(data), n, offset);
+	}
+
+	namespace detail
+	{
+		// Load Size-byte field from n records (src points to the field of the first record)
+		template <std::size_t Size, bool Native>
+		inline void gather_generic(uchar* dst, const uchar* src, std::size_t stride, std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; i++, dst += Size, src += stride)
+			{
+				const auto value = load_value<Size, Native>(src);
+				std::memcpy(dst, &value, Size);
+			}
+		}
+
+		template <std::size_t Size, bool Native>
+		inline void scatter_generic(uchar* dst, const uchar* src, std::size_t stride, std::size_t n)
+		{
+			using U = typename uint_of_size<Size>::type;
+			using buf = endian_buffer<U, Size, 1>;
+
+			for (std::size_t i = 0; i < n; i++, dst += stride, src += Size)
+			{
+				U value;
+				std::memcpy(&value, src, Size);
+				Native ? buf::put_ne(*reinterpret_cast<buf*>(dst), value) : buf::put_re(*reinterpret_cast<buf*>(dst), value);
+			}
+		}
+
+		// Maximal stride for 32-bit gather/scatter indices
+		constexpr std::size_t gather_max_stride = 0x7fffffff / 16;
+
+#if defined(ENDIAN_X86)
+		template <std::size_t Size, bool Native>
+		ENDIAN_TARGET("avx2") inline void gather_avx2(uchar* dst, const uchar* src, std::size_t stride, std::size_t n)
+		{
+			const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(bswap_mask<Native ? 1 : Size>()));
+
+			std::size_t i = 0;
+
+			if (Size == 4 && stride <= gather_max_stride)
+			{
+				const __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(stride)));
+
+				for (; i + 8 <= n; i += 8)
+				{
+					const __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src + i * stride), index, 1);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * Size), _mm256_shuffle_epi8(v, mask));
+				}
+			}
+
+			if (Size == 8)
+			{
+				const long long s = static_cast<long long>(stride);
+				const __m256i index = _mm256_setr_epi64x(0, s, s * 2, s * 3);
+
+				for (; i + 4 <= n; i += 4)
+				{
+					const __m256i v = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(src + i * stride), index, 1);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * Size), _mm256_shuffle_epi8(v, mask));
+				}
+			}
+
+			gather_generic<Size, Native>(dst + i * Size, src + i * stride, stride, n - i);
+		}
+
+		template <std::size_t Size, bool Native>
+		ENDIAN_TARGET("avx512f,avx512bw") inline void gather_avx512(uchar* dst, const uchar* src, std::size_t stride, std::size_t n)
+		{
+			const __m512i mask = _mm512_load_si512(bswap_mask<Native ? 1 : Size>());
+
+			std::size_t i = 0;
+
+			if (Size == 4 && stride <= gather_max_stride)
+			{
+				const __m512i index = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(static_cast<int>(stride)));
+
+				for (; i + 16 <= n; i += 16)
+				{
+					const __m512i v = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xffff, index, src + i * stride, 1);
+					_mm512_storeu_si512(dst + i * Size, _mm512_shuffle_epi8(v, mask));
+				}
+			}
+
+			if (Size == 8)
+			{
+				const long long s = static_cast<long long>(stride);
+				const __m512i index = _mm512_setr_epi64(0, s, s * 2, s * 3, s * 4, s * 5, s * 6, s * 7);
+
+				for (; i + 8 <= n; i += 8)
+				{
+					const __m512i v = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), 0xff, index, src + i * stride, 1);
+					_mm512_storeu_si512(dst + i * Size, _mm512_shuffle_epi8(v, mask));
+				}
+			}
+
+			gather_generic<Size, Native>(dst + i * Size, src + i * stride, stride, n - i);
+		}
+
+		template <std::size_t Size, bool Native>
+		ENDIAN_TARGET("avx512f,avx512bw") inline void scatter_avx512(uchar* dst, const uchar* src, std::size_t stride, std::size_t n)
+		{
+			const __m512i mask = _mm512_load_si512(bswap_mask<Native ? 1 : Size>());
+
+			std::size_t i = 0;
+
+			if (Size == 4 && stride <= gather_max_stride)
+			{
+				const __m512i index = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(static_cast<int>(stride)));
+
+				for (; i + 16 <= n; i += 16)
+				{
+					const __m512i v = _mm512_shuffle_epi8(_mm512_loadu_si512(src + i * Size), mask);
+					_mm512_i32scatter_epi32(dst + i * stride, index, v, 1);
+				}
+			}
+
+			if (Size == 8)
+			{
+				const long long s = static_cast<long long>(stride);
+				const __m512i index = _mm512_setr_epi64(0, s, s * 2, s * 3, s * 4, s * 5, s * 6, s * 7);
+
+				for (; i + 8 <= n; i += 8)
+				{
+					const __m512i v = _mm512_shuffle_epi8(_mm512_loadu_si512(src + i * Size), mask);
+					_mm512_i64scatter_epi64(dst + i * stride, index, v, 1);
+				}
+			}
+
+			scatter_generic<Size, Native>(dst + i * stride, src + i * Size, stride, n - i);
+		}
+#endif
+
+		using gather_func = void (*)(uchar* dst, const uchar* src, std::size_t stride, std::size_t n);
+
+		template <std::size_t Size, bool Native>
+		inline void gather_n(void* dst, const void* src, std::size_t stride, std::size_t n)
+		{
+			static const gather_func func = []() -> gather_func {
+				if (Size != 4 && Size != 8)
+				{
+					return gather_generic<Size, Native>;
+				}
+
+#if defined(ENDIAN_X86_DISPATCH)
+				__builtin_cpu_init();
+
+				if (__builtin_cpu_supports("avx512bw"))
+					return gather_avx512<Size, Native>;
+				if (__builtin_cpu_supports("avx2"))
+					return gather_avx2<Size, Native>;
+#elif defined(ENDIAN_X86) && defined(__AVX512BW__)
+				return gather_avx512<Size, Native>;
+#elif defined(ENDIAN_X86) && defined(__AVX2__)
+				return gather_avx2<Size, Native>;
+#endif
+				return gather_generic<Size, Native>;
+			}();
+
+			func(static_cast<uchar*>(dst), static_cast<const uchar*>(src), stride, n);
+		}
+
+		template <std::size_t Size, bool Native>
+		inline void scatter_n(void* dst, const void* src, std::size_t stride, std::size_t n)
+		{
+			static const gather_func func = []() -> gather_func {
+				if (Size != 4 && Size != 8)
+				{
+					return scatter_generic<Size, Native>;
+				}
+
+#if defined(ENDIAN_X86_DISPATCH)
+				__builtin_cpu_init();
+
+				if (__builtin_cpu_supports("avx512bw"))
+					return scatter_avx512<Size, Native>;
+#elif defined(ENDIAN_X86) && defined(__AVX512BW__)
+				return scatter_avx512<Size, Native>;
+#endif
+				return scatter_generic<Size, Native>;
+			}();
+
+			func(static_cast<uchar*>(dst), static_cast<const uchar*>(src), stride, n);
+		}
+
+		// Records per block for multi-column functions (about 16 KiB)
+		inline std::size_t column_block(std::size_t stride)
+		{
+			return stride < 1024 ? 16384 / (stride ? stride : 1) : 16;
+		}
+	}
+
+	// Column descriptor for multi-field gather/scatter: native array and field offset in record
+	template <typename T>
+	struct column
+	{
+		T* data;
+		std::size_t offset;
+	};
+
+#if defined(__cpp_deduction_guides)
+	template <typename T>
+	column(T*, std::size_t) -> column<T>;
+#endif
+
+#ifdef __BIG_ENDIAN__
+#define LE_NATIVE false
+#define BE_NATIVE true
+#else
+#define LE_NATIVE true
+#define BE_NATIVE false
+#endif
+
+	// Load field at `offset` from n records of `stride` bytes into native array (AVX2/AVX-512 gather for 4 and 8 bytes)
+	template <typename T>
+	void le_gather(T* dst, const void* base, std::size_t stride, std::size_t offset, std::size_t n)
+	{
+		static_assert(has_endianness<T>::value && !std::is_void<typename detail::uint_of_size<sizeof(T)>::type>::value, "le_gather<>: invalid type");
+		detail::gather_n<sizeof(T), LE_NATIVE>(dst, static_cast<const detail::uchar*>(base) + offset, stride, n);
+	}
+
+	template <typename T>
+	void be_gather(T* dst, const void* base, std::size_t stride, std::size_t offset, std::size_t n)
+	{
+		static_assert(has_endianness<T>::value && !std::is_void<typename detail::uint_of_size<sizeof(T)>::type>::value, "be_gather<>: invalid type");
+		detail::gather_n<sizeof(T), BE_NATIVE>(dst, static_cast<const detail::uchar*>(base) + offset, stride, n);
+	}
+
+	// Store native array into field at `offset` of n records of `stride` bytes
+	template <typename T>
+	void le_scatter(void* base, std::size_t stride, std::size_t offset, const T* src, std::size_t n)
+	{
+		static_assert(has_endianness<T>::value && !std::is_void<typename detail::uint_of_size<sizeof(T)>::type>::value, "le_scatter<>: invalid type");
+		detail::scatter_n<sizeof(T), LE_NATIVE>(static_cast<detail::uchar*>(base) + offset, src, stride, n);
+	}
+
+	template <typename T>
+	void be_scatter(void* base, std::size_t stride, std::size_t offset, const T* src, std::size_t n)
+	{
+		static_assert(has_endianness<T>::value && !std::is_void<typename detail::uint_of_size<sizeof(T)>::type>::value, "be_scatter<>: invalid type");
+		detail::scatter_n<sizeof(T), BE_NATIVE>(static_cast<detail::uchar*>(base) + offset, src, stride, n);
+	}
+
+	// Load multiple fields from n records in one pass (processed in cache-sized blocks of records)
+	template <typename... T>
+	void le_gather_columns(const void* base, std::size_t stride, std::size_t n, column<T>... columns)
+	{
+		const std::size_t block = detail::column_block(stride);
+
+		for (std::size_t i = 0; i < n; i += block)
+		{
+			const std::size_t count = n - i < block ? n - i : block;
+			const detail::uchar* records = static_cast<const detail::uchar*>(base) + i * stride;
+			const int dummy[]{0, (le_gather(columns.data + i, records, stride, columns.offset, count), 0)...};
+			static_cast<void>(dummy);
+		}
+	}
+
+	template <typename... T>
+	void be_gather_columns(const void* base, std::size_t stride, std::size_t n, column<T>... columns)
+	{
+		const std::size_t block = detail::column_block(stride);
+
+		for (std::size_t i = 0; i < n; i += block)
+		{
+			const std::size_t count = n - i < block ? n - i : block;
+			const detail::uchar* records = static_cast<const detail::uchar*>(base) + i * stride;
+			const int dummy[]{0, (be_gather(columns.data + i, records, stride, columns.offset, count), 0)...};
+			static_cast<void>(dummy);
+		}
+	}
+
+	// Store multiple fields of n records in one pass
+	template <typename... T>
+	void le_scatter_columns(void* base, std::size_t stride, std::size_t n, column<T>... columns)
+	{
+		const std::size_t block = detail::column_block(stride);
+
+		for (std::size_t i = 0; i < n; i += block)
+		{
+			const std::size_t count = n - i < block ? n - i : block;
+			detail::uchar* records = static_cast<detail::uchar*>(base) + i * stride;
+			const int dummy[]{0, (le_scatter(records, stride, columns.offset, columns.data + i, count), 0)...};
+			static_cast<void>(dummy);
+		}
+	}
+
+	template <typename... T>
+	void be_scatter_columns(void* base, std::size_t stride, std::size_t n, column<T>... columns)
+	{
+		const std::size_t block = detail::column_block(stride);
+
+		for (std::size_t i = 0; i < n; i += block)
+		{
+			const std::size_t count = n - i < block ? n - i : block;
+			detail::uchar* records = static_cast<detail::uchar*>(base) + i * stride;
+			const int dummy[]{0, (be_scatter(records, stride, columns.offset, columns.data + i, count), 0)...};
+			static_cast<void>(dummy);
+		}
+	}
+
+#undef LE_NATIVE
+#undef BE_NATIVE
+
+	// Rounding mode for float to half/bfloat16 conversion (same order as vcvtps2ph immediate)
+	enum class fp_round
+	{
+		nearest_even,
+		down,
+		up,
+		toward_zero,
+	};
+
+	namespace detail
+	{
+		// Round and shift right: increment truncated magnitude according to rounding mode and removed bits
+		inline std::uint32_t fp_round_shift(std::uint32_t value, unsigned shift, bool sign, fp_round mode)
+		{
+			const std::uint32_t result = value >> shift;
+			const std::uint64_t rem = value & ((std::uint64_t{1} << shift) - 1);
+			const std::uint64_t half = std::uint64_t{1} << shift >> 1;
+
+			switch (mode)
+			{
+			case fp_round::nearest_even: return result + (rem > half || (rem == half && (result & 1)));
+			case fp_round::down: return result + (sign && rem);
+			case fp_round::up: return result + (!sign && rem);
+			default: return result;
+			}
+		}
+
+		inline std::uint16_t f32_to_f16(float value, fp_round mode)
+		{
+			const std::uint32_t x = bit_cast<std::uint32_t>(value);
+			const std::uint32_t sign = x >> 16 & 0x8000;
+			const std::uint32_t abs = x & 0x7fffffff;
+
+			// Inf and NaN (quiet)
+			if (abs >= 0x7f800000)
+			{
+				return static_cast<std::uint16_t>(sign | (abs > 0x7f800000 ? 0x7e00 | (abs >> 13 & 0x3ff) : 0x7c00));
+			}
+
+			const int exp = static_cast<int>(abs >> 23) - 127 + 15;
+
+			// Overflow
+			if (exp >= 31)
+			{
+				const bool max = mode == fp_round::toward_zero || (mode == fp_round::up && sign) || (mode == fp_round::down && !sign);
+				return static_cast<std::uint16_t>(sign | (max ? 0x7bff : 0x7c00));
+			}
+
+			// Mantissa with explicit leading bit (none for f32 subnormals), shifted to half precision (subnormals if exp < 1)
+			const std::uint32_t mant = abs < 0x800000 ? abs : (abs & 0x7fffff) | 0x800000;
+			const int texp = abs < 0x800000 ? -111 : exp;
+			const unsigned shift = texp >= 1 ? 13 : 13 + 1 - texp > 31 ? 31 : 13 + 1 - texp;
+
+			// Carry from rounding propagates into exponent (up to infinity)
+			return static_cast<std::uint16_t>(sign | (((texp >= 1 ? texp - 1 : 0) << 10) + fp_round_shift(mant, shift, sign != 0, mode)));
+		}
+
+		inline float f16_to_f32(std::uint16_t value)
+		{
+			const std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000) << 16;
+			const std::uint32_t exp = value >> 10 & 0x1f;
+			std::uint32_t mant = value & 0x3ff;
+
+			// NaN is quieted (same as F16C and NEON)
+			if (exp == 0x1f)
+			{
+				return bit_cast<float>(sign | 0x7f800000 | mant << 13 | (mant ? 0x400000 : 0));
+			}
+
+			if (exp == 0)
+			{
+				if (mant == 0)
+				{
+					return bit_cast<float>(sign);
+				}
+
+				// Normalize subnormal
+				std::uint32_t e = 113;
+
+				while (!(mant & 0x400))
+				{
+					mant <<= 1;
+					e--;
+				}
+
+				return bit_cast<float>(sign | e << 23 | (mant & 0x3ff) << 13);
+			}
+
+			return bit_cast<float>(sign | (exp + 112) << 23 | mant << 13);
+		}
+
+		inline std::uint16_t f32_to_bf16(float value, fp_round mode)
+		{
+			const std::uint32_t x = bit_cast<std::uint32_t>(value);
+
+			// NaN (quiet)
+			if ((x & 0x7fffffff) > 0x7f800000)
+			{
+				return static_cast<std::uint16_t>(x >> 16 | 0x40);
+			}
+
+			const std::uint32_t sign = x & 0x80000000;
+			const std::uint32_t abs = x & 0x7fffffff;
+			const std::uint32_t result = fp_round_shift(abs, 16, sign != 0, mode);
+
+			// Infinity is only reachable by rounding away from zero
+			return static_cast<std::uint16_t>(sign >> 16 | result);
+		}
+
+		inline float bf16_to_f32(std::uint16_t value)
+		{
+			return bit_cast<float>(static_cast<std::uint32_t>(value) << 16);
+		}
+	}
+
+	// IEEE 754 binary16 (storage type, converts to float)
+	struct half
+	{
+		std::uint16_t bits;
+
+		half() = default;
+
+		explicit half(float value, fp_round mode = fp_round::nearest_even)
+			: bits(detail::f32_to_f16(value, mode))
+		{
+		}
+
+		operator float() const
+		{
+			return detail::f16_to_f32(bits);
+		}
+
+		static constexpr half from_bits(std::uint16_t bits)
+		{
+			return half(bits, 0);
+		}
+
+	private:
+		constexpr half(std::uint16_t bits, int)
+			: bits(bits)
+		{
+		}
+	};
+
+	// bfloat16 (upper half of float, storage type, converts to float)
+	struct bfloat16
+	{
+		std::uint16_t bits;
+
+		bfloat16() = default;
+
+		explicit bfloat16(float value, fp_round mode = fp_round::nearest_even)
+			: bits(detail::f32_to_bf16(value, mode))
+		{
+		}
+
+		operator float() const
+		{
+			return detail::bf16_to_f32(bits);
+		}
+
+		static constexpr bfloat16 from_bits(std::uint16_t bits)
+		{
+			return bfloat16(bits, 0);
+		}
+
+	private:
+		constexpr bfloat16(std::uint16_t bits, int)
+			: bits(bits)
+		{
+		}
+	};
+
+	template <>
+	struct has_endianness<half> : std::true_type
+	{
+	};
+
+	template <>
+	struct has_endianness<bfloat16> : std::true_type
+	{
+	};
+
+	namespace detail
+	{
+		template <bool Native>
+		inline void f16_to_f32_generic(uchar* dst, const uchar* src, std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; i++, src += 2, dst += 4)
+			{
+				const float value = f16_to_f32(load_value<2, Native>(src));
+				std::memcpy(dst, &value, 4);
+			}
+		}
+
+		template <bool Native>
+		inline void bf16_to_f32_generic(uchar* dst, const uchar* src, std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; i++, src += 2, dst += 4)
+			{
+				const float value = bf16_to_f32(load_value<2, Native>(src));
+				std::memcpy(dst, &value, 4);
+			}
+		}
+
+		template <bool Native, bool Brain>
+		inline void f32_to_f16_generic(uchar* dst, const uchar* src, std::size_t n, fp_round mode)
+		{
+			using buf = endian_buffer<std::uint16_t, 2, 1>;
+
+			for (std::size_t i = 0; i < n; i++, src += 4, dst += 2)
+			{
+				float value;
+				std::memcpy(&value, src, 4);
+				const std::uint16_t bits = Brain ? f32_to_bf16(value, mode) : f32_to_f16(value, mode);
+				Native ? buf::put_ne(*reinterpret_cast<buf*>(dst), bits) : buf::put_re(*reinterpret_cast<buf*>(dst), bits);
+			}
+		}
+
+#if defined(ENDIAN_X86)
+		template <bool Native>
+		ENDIAN_TARGET("avx,f16c") inline void f16_to_f32_f16c(uchar* dst, const uchar* src, std::size_t n)
+		{
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(bswap_mask<Native ? 1 : 2>()));
+
+			std::size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2)), mask);
+				_mm256_storeu_ps(reinterpret_cast<float*>(dst + i * 4), _mm256_cvtph_ps(v));
+			}
+
+			f16_to_f32_generic<Native>(dst + i * 4, src + i * 2, n - i);
+		}
+
+		template <bool Native, int Mode>
+		ENDIAN_TARGET("avx,f16c") inline void f32_to_f16_f16c(uchar* dst, const uchar* src, std::size_t n)
+		{
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(bswap_mask<Native ? 1 : 2>()));
+
+			std::size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m128i v = _mm256_cvtps_ph(_mm256_loadu_ps(reinterpret_cast<const float*>(src + i * 4)), Mode);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_shuffle_epi8(v, mask));
+			}
+
+			f32_to_f16_generic<Native, false>(dst + i * 2, src + i * 4, n - i, static_cast<fp_round>(Mode));
+		}
+
+		template <bool Native>
+		ENDIAN_TARGET("ssse3") inline void bf16_to_f32_ssse3(uchar* dst, const uchar* src, std::size_t n)
+		{
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(bswap_mask<Native ? 1 : 2>()));
+			const __m128i zero = _mm_setzero_si128();
+
+			std::size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2)), mask);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_unpacklo_epi16(zero, v));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4 + 16), _mm_unpackhi_epi16(zero, v));
+			}
+
+			bf16_to_f32_generic<Native>(dst + i * 4, src + i * 2, n - i);
+		}
+
+		// Round to nearest even (x + 0x7fff + lsb), NaN is quieted
+		ENDIAN_TARGET("ssse3") inline __m128i f32_to_bf16_rne(__m128i x)
+		{
+			const __m128i abs = _mm_and_si128(x, _mm_set1_epi32(0x7fffffff));
+			const __m128i nan = _mm_cmpgt_epi32(abs, _mm_set1_epi32(0x7f800000));
+			const __m128i lsb = _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(1));
+			const __m128i r = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(x, _mm_set1_epi32(0x7fff)), lsb), 16);
+			const __m128i q = _mm_or_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(0x40));
+			const __m128i result = _mm_or_si128(_mm_and_si128(nan, q), _mm_andnot_si128(nan, r));
+
+			// Sign-extend to pack with signed saturation
+			return _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+		}
+
+		template <bool Native>
+		ENDIAN_TARGET("ssse3") inline void f32_to_bf16_ssse3(uchar* dst, const uchar* src, std::size_t n)
+		{
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(bswap_mask<Native ? 1 : 2>()));
+
+			std::size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m128i lo = f32_to_bf16_rne(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4)));
+				const __m128i hi = f32_to_bf16_rne(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4 + 16)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_shuffle_epi8(_mm_packs_epi32(lo, hi), mask));
+			}
+
+			f32_to_f16_generic<Native, true>(dst + i * 2, src + i * 4, n - i, fp_round::nearest_even);
+		}
+#elif defined(ENDIAN_NEON) && defined(__aarch64__) && !defined(__BIG_ENDIAN__)
+		template <bool Native>
+		inline void f16_to_f32_neon(uchar* dst, const uchar* src, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				const uint8x8_t v = Native ? vld1_u8(src + i * 2) : vrev16_u8(vld1_u8(src + i * 2));
+				vst1q_f32(reinterpret_cast<float*>(dst + i * 4), vcvt_f32_f16(vreinterpret_f16_u8(v)));
+			}
+
+			f16_to_f32_generic<Native>(dst + i * 4, src + i * 2, n - i);
+		}
+
+		// FPCR rounding mode is assumed to be round to nearest even (default)
+		template <bool Native>
+		inline void f32_to_f16_neon(uchar* dst, const uchar* src, std::size_t n)
+		{
+			std::size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				const uint8x8_t v = vreinterpret_u8_f16(vcvt_f16_f32(vld1q_f32(reinterpret_cast<const float*>(src + i * 4))));
+				vst1_u8(dst + i * 2, Native ? v : vrev16_u8(v));
+			}
+
+			f32_to_f16_generic<Native, false>(dst + i * 2, src + i * 4, n - i, fp_round::nearest_even);
+		}
+#endif
+
+		template <bool Native, bool Brain>
+		inline void half_to_f32_n(float* dst, const void* src, std::size_t n)
+		{
+			static const bswap_n_func func = []() -> bswap_n_func {
+#if defined(ENDIAN_X86_DISPATCH)
+				__builtin_cpu_init();
+
+				if (!Brain && __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c"))
+					return f16_to_f32_f16c<Native>;
+				if (Brain && __builtin_cpu_supports("ssse3"))
+					return bf16_to_f32_ssse3<Native>;
+#elif defined(ENDIAN_X86) && defined(__F16C__)
+				return Brain ? bf16_to_f32_ssse3<Native> : f16_to_f32_f16c<Native>;
+#elif defined(ENDIAN_X86) && (defined(__SSSE3__) || defined(__AVX__))
+				if (Brain)
+					return bf16_to_f32_ssse3<Native>;
+#elif defined(ENDIAN_NEON) && defined(__aarch64__) && !defined(__BIG_ENDIAN__)
+				if (!Brain)
+					return f16_to_f32_neon<Native>;
+#endif
+				return Brain ? bf16_to_f32_generic<Native> : f16_to_f32_generic<Native>;
+			}();
+
+			func(reinterpret_cast<uchar*>(dst), static_cast<const uchar*>(src), n);
+		}
+
+		template <bool Native, bool Brain>
+		inline void f32_to_half_generic(uchar* dst, const uchar* src, std::size_t n)
+		{
+			f32_to_f16_generic<Native, Brain>(dst, src, n, fp_round::nearest_even);
+		}
+
+		template <bool Native, bool Brain, int Mode>
+		inline bswap_n_func select_f32_to_half()
+		{
+#if defined(ENDIAN_X86_DISPATCH)
+			__builtin_cpu_init();
+
+			if (!Brain && __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c"))
+				return f32_to_f16_f16c<Native, Mode>;
+			if (Brain && Mode == 0 && __builtin_cpu_supports("ssse3"))
+				return f32_to_bf16_ssse3<Native>;
+#elif defined(ENDIAN_X86) && defined(__F16C__)
+			if (!Brain)
+				return f32_to_f16_f16c<Native, Mode>;
+			if (Mode == 0)
+				return f32_to_bf16_ssse3<Native>;
+#elif defined(ENDIAN_X86) && (defined(__SSSE3__) || defined(__AVX__))
+			if (Brain && Mode == 0)
+				return f32_to_bf16_ssse3<Native>;
+#elif defined(ENDIAN_NEON) && defined(__aarch64__) && !defined(__BIG_ENDIAN__)
+			if (!Brain && Mode == 0)
+				return f32_to_f16_neon<Native>;
+#endif
+			return Mode == 0 ? f32_to_half_generic<Native, Brain> : nullptr;
+		}
+
+		template <bool Native, bool Brain>
+		inline void f32_to_half_n(void* dst, const float* src, std::size_t n, fp_round mode)
+		{
+			static const bswap_n_func funcs[4]{
+				select_f32_to_half<Native, Brain, 0>(),
+				select_f32_to_half<Native, Brain, 1>(),
+				select_f32_to_half<Native, Brain, 2>(),
+				select_f32_to_half<Native, Brain, 3>(),
+			};
+
+			if (const auto func = funcs[static_cast<int>(mode) & 3])
+			{
+				return func(static_cast<uchar*>(dst), reinterpret_cast<const uchar*>(src), n);
+			}
+
+			f32_to_f16_generic<Native, Brain>(static_cast<uchar*>(dst), reinterpret_cast<const uchar*>(src), n, mode);
+		}
+	}
+
+	// Load n LE/BE half (binary16) values as float (F16C: byteswap + vcvtph2ps in one pass)
+	inline void le_f16_to_f32_n(float* dst, const void* src, std::size_t n)
+	{
+		detail::half_to_f32_n<endian::native == endian::little, false>(dst, src, n);
+	}
+
+	inline void be_f16_to_f32_n(float* dst, const void* src, std::size_t n)
+	{
+		detail::half_to_f32_n<endian::native == endian::big, false>(dst, src, n);
+	}
+
+	// Store n float values as LE/BE half with given rounding mode (F16C: vcvtps2ph + byteswap)
+	inline void le_f32_to_f16_n(void* dst, const float* src, std::size_t n, fp_round mode = fp_round::nearest_even)
+	{
+		detail::f32_to_half_n<endian::native == endian::little, false>(dst, src, n, mode);
+	}
+
+	inline void be_f32_to_f16_n(void* dst, const float* src, std::size_t n, fp_round mode = fp_round::nearest_even)
+	{
+		detail::f32_to_half_n<endian::native == endian::big, false>(dst, src, n, mode);
+	}
+
+	// Same for bfloat16
+	inline void le_bf16_to_f32_n(float* dst, const void* src, std::size_t n)
+	{
+		detail::half_to_f32_n<endian::native == endian::little, true>(dst, src, n);
+	}
+
+	inline void be_bf16_to_f32_n(float* dst, const void* src, std::size_t n)
+	{
+		detail::half_to_f32_n<endian::native == endian::big, true>(dst, src, n);
+	}
+
+	inline void le_f32_to_bf16_n(void* dst, const float* src, std::size_t n, fp_round mode = fp_round::nearest_even)
+	{
+		detail::f32_to_half_n<endian::native == endian::little, true>(dst, src, n, mode);
+	}
+
+	inline void be_f32_to_bf16_n(void* dst, const float* src, std::size_t n, fp_round mode = fp_round::nearest_even)
+	{
+		detail::f32_to_half_n<endian::native == endian::big, true>(dst, src, n, mode);
+	}
+
+	// Byte permutation: memory byte i holds value byte I[i] (byte 0 is the least significant)
+	template <std::size_t... I>
+	struct byte_order
+	{
+		static constexpr std::size_t size = sizeof...(I);
+
+		static constexpr std::size_t at(std::size_t i)
+		{
+			const std::size_t order[]{I...};
+			return order[i];
+		}
+
+		// Memory position of value byte
+		static constexpr std::size_t find(std::size_t value_byte)
+		{
+			const std::size_t order[]{I...};
+
+			for (std::size_t i = 0; i < sizeof...(I); i++)
+			{
+				if (order[i] == value_byte)
+				{
+					return i;
+				}
+			}
+
+			return sizeof...(I);
+		}
+
+		// Each value byte 0..size-1 occurs exactly once
+		static constexpr bool is_permutation()
+		{
+			for (std::size_t j = 0; j < sizeof...(I); j++)
+			{
+				if (find(j) == sizeof...(I))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	};
+
+	namespace detail
+	{
+		template <std::size_t Size, std::size_t Word, typename = std::make_index_sequence<Size>>
+		struct word_swapped;
+
+		template <std::size_t Size, std::size_t Word, std::size_t... I>
+		struct word_swapped<Size, Word, std::index_sequence<I...>>
+		{
+			static_assert(Word > 0 && Size % Word == 0, "word_swapped_order<>: invalid word size");
+
+			using type = byte_order<((Size / Word - 1 - I / Word) * Word + I % Word)...>;
+		};
+	}
+
+	// Little endian words of `Word` bytes stored in big endian order (Word == 1: BE, Word == Size: LE)
+	template <std::size_t Size, std::size_t Word>
+	using word_swapped_order = typename detail::word_swapped<Size, Word>::type;
+
+	template <std::size_t Size>
+	using le_order = word_swapped_order<Size, Size>;
+
+	template <std::size_t Size>
+	using be_order = word_swapped_order<Size, 1>;
+
+	namespace detail
+	{
+		template <typename U>
+		ENDIAN_CONSTEXPR U bswap_int(U value)
+		{
+#if defined(_MSC_VER) || defined(__GNUG__)
+			return endian_buffer<U, sizeof(U), sizeof(U)>::swap(value);
+#else
+			return revert_int(value);
+#endif
+		}
+
+		template <typename U>
+		ENDIAN_CONSTEXPR U rotr_int(U value, std::size_t bits)
+		{
+			return bits == 0 ? value : static_cast<U>(value >> bits | value << (sizeof(U) * 8 - bits));
+		}
+
+		// Byte permutation of integer: result byte j is Map::src(j) byte of the argument.
+		// Lowered to the cheapest of: nothing, bswap, rotate, bswap + rotate, bswap + swap within words, byte by byte.
+		template <typename U, typename Map>
+		struct permute_int
+		{
+			static constexpr std::size_t size = sizeof(U);
+
+			// Result byte j is argument byte (j + k) % size
+			static constexpr bool is_rotate(std::size_t k)
+			{
+				for (std::size_t j = 0; j < size; j++)
+				{
+					if (Map::src(j) != (j + k) % size)
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			// Same after bswap
+			static constexpr bool is_bswap_rotate(std::size_t k)
+			{
+				for (std::size_t j = 0; j < size; j++)
+				{
+					if (Map::src(j) != size - 1 - (j + k) % size)
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			// Bytes within words of w bytes are reversed after bswap
+			static constexpr bool is_bswap_words(std::size_t w)
+			{
+				for (std::size_t j = 0; j < size; j++)
+				{
+					if (Map::src(j) != size - 1 - (j / w * w + w - 1 - j % w))
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			// 0: rotate by `arg` bytes, 1: bswap + rotate, 2: bswap + reverse bytes in `arg`-byte words, 3: generic
+			static constexpr std::size_t kind()
+			{
+				for (std::size_t k = 0; k < size; k++)
+				{
+					if (is_rotate(k))
+						return 0;
+					if (is_bswap_rotate(k))
+						return 1;
+				}
+
+				for (std::size_t w = 2; w < size; w *= 2)
+				{
+					if (is_bswap_words(w))
+						return 2;
+				}
+
+				return 3;
+			}
+
+			static constexpr std::size_t arg()
+			{
+				for (std::size_t k = 0; k < size; k++)
+				{
+					if (is_rotate(k) || is_bswap_rotate(k))
+						return k;
+				}
+
+				for (std::size_t w = 2; w < size; w *= 2)
+				{
+					if (is_bswap_words(w))
+						return w;
+				}
+
+				return 0;
+			}
+
+			// Mask of lower halves of 2 * step byte groups
+			static constexpr U group_mask(std::size_t step)
+			{
+				U result = 0;
+
+				for (std::size_t i = 0; i < size; i++)
+				{
+					if (i % (step * 2) < step)
+					{
+						result |= static_cast<U>(U{0xff} << (i * 8));
+					}
+				}
+
+				return result;
+			}
+
+			static ENDIAN_CONSTEXPR U apply(U value, std::integral_constant<std::size_t, 0>)
+			{
+				return rotr_int(value, arg() * 8);
+			}
+
+			static ENDIAN_CONSTEXPR U apply(U value, std::integral_constant<std::size_t, 1>)
+			{
+				return rotr_int(bswap_int(value), arg() * 8);
+			}
+
+			static ENDIAN_CONSTEXPR U apply(U value, std::integral_constant<std::size_t, 2>)
+			{
+				value = bswap_int(value);
+
+				for (std::size_t step = 1; step < arg(); step *= 2)
+				{
+					const U mask = group_mask(step);
+					value = static_cast<U>((value & mask) << (step * 8) | (value >> (step * 8) & mask));
+				}
+
+				return value;
+			}
+
+			static ENDIAN_CONSTEXPR U apply(U value, std::integral_constant<std::size_t, 3>)
+			{
+				U result = 0;
+
+				for (std::size_t j = 0; j < size; j++)
+				{
+					result |= static_cast<U>((value >> (Map::src(j) * 8) & 0xff) << (j * 8));
+				}
+
+				return result;
+			}
+
+			static ENDIAN_CONSTEXPR U apply(U value)
+			{
+				return apply(value, std::integral_constant<std::size_t, kind()>());
+			}
+		};
+
+		// Position of memory byte in native integer
+		constexpr std::size_t native_pos(std::size_t i, std::size_t size)
+		{
+			return endian::native == endian::little ? i : size - 1 - i;
+		}
+
+		// Load: storage loaded as native integer -> value
+		template <typename Order>
+		struct permute_load_map
+		{
+			static constexpr std::size_t src(std::size_t j)
+			{
+				return native_pos(Order::find(j), Order::size);
+			}
+		};
+
+		// Store: value -> storage as native integer
+		template <typename Order>
+		struct permute_store_map
+		{
+			static constexpr std::size_t src(std::size_t r)
+			{
+				return Order::at(native_pos(r, Order::size));
+			}
+		};
+	}
+
+	// Value of type T stored with arbitrary byte permutation `Order` (such as word_swapped_order<4, 2> for PDP-11).
+	// permuted_base<T, be_order<sizeof(T)>> has the same layout as be_t<T>, le_order -- as le_t<T>.
+	template <typename T, typename Order, std::size_t Align = alignof(T)>
+	class permuted_base
+	{
+		static_assert(has_endianness<T>::value && Order::size == sizeof(T), "permuted_base<>: invalid type");
+		static_assert(Order::is_permutation(), "permuted_base<>: invalid byte order (not a permutation)");
+		static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 || sizeof(T) == 16, "permuted_base<>: invalid size");
+
+		using raw_t = typename detail::uint_of_size<sizeof(T)>::type;
+		using buf = detail::endian_buffer<raw_t, sizeof(T), Align>;
+
+		typename buf::type data;
+
+	public:
+		using value_type = T;
+		using order = Order;
+
+		permuted_base() = default;
+
+		ENDIAN_CONSTEXPR permuted_base(const T& value)
+			: data{}
+		{
+			set(value);
+		}
+
+		permuted_base& operator=(const permuted_base&) = default;
+
+		ENDIAN_CONSTEXPR permuted_base& operator=(const T& value)
+		{
+			set(value);
+			return *this;
+		}
+
+		ENDIAN_CONSTEXPR operator T() const
+		{
+			return get();
+		}
+
+		ENDIAN_CONSTEXPR T get() const
+		{
+			return detail::bit_cast<T>(detail::permute_int<raw_t, detail::permute_load_map<Order>>::apply(buf::get_ne(data)));
+		}
+
+		ENDIAN_CONSTEXPR void set(const T& value)
+		{
+			buf::put_ne(data, detail::permute_int<raw_t, detail::permute_store_map<Order>>::apply(detail::bit_cast<raw_t>(value)));
+		}
+
+		// Comparison of storage
+		friend ENDIAN_CONSTEXPR bool operator==(const permuted_base& lhs, const permuted_base& rhs)
+		{
+			return buf::get_ne(lhs.data) == buf::get_ne(rhs.data);
+		}
+
+		friend ENDIAN_CONSTEXPR bool operator!=(const permuted_base& lhs, const permuted_base& rhs)
+		{
+			return !(lhs == rhs);
+		}
+	};
+
+	// PDP-11 middle endian (16-bit words in big endian order), also 64-bit values with swapped 16-bit words
+	template <typename T, std::size_t A = alignof(T)>
+	using pdp_t = permuted_base<T, word_swapped_order<sizeof(T), 2>, A>;
+
+	// Little endian 32-bit words in big endian order (ARM FPA double)
+	template <typename T, std::size_t A = alignof(T)>
+	using fpa_t = permuted_base<T, word_swapped_order<sizeof(T), 4>, A>;
+
+	namespace detail
+	{
+		// Shuffle mask for 16 bytes of elements: Load (storage -> native) or store (native -> storage)
+		template <typename Order, bool Load>
+		constexpr shuffle_mask<16> permute_mask()
+		{
+			constexpr std::size_t size = Order::size;
+
+			shuffle_mask<16> result{};
+
+			for (std::size_t e = 0; e < 16 / size; e++)
+			{
+				for (std::size_t i = 0; i < size; i++)
+				{
+					// Load: native byte i is value byte native_pos(i) from storage; store: storage byte i is value byte at(i)
+					result.data[e * size + i] = static_cast<uchar>(e * size + (Load ? Order::find(native_pos(i, size)) : native_pos(Order::at(i), size)));
+				}
+			}
+
+			return result;
+		}
+
+		template <typename Order, bool Load>
+		inline const uchar* permute_mask_data()
+		{
+			alignas(16) static const shuffle_mask<16> mask = permute_mask<Order, Load>();
+			return mask.data;
+		}
+
+		template <typename Order, bool Load, typename U = typename uint_of_size<Order::size>::type>
+		inline void permute_n_generic(uchar* dst, const uchar* src, std::size_t n)
+		{
+			using map = std::conditional_t<Load, permute_load_map<Order>, permute_store_map<Order>>;
+
+			for (std::size_t i = 0; i < n; i++, dst += sizeof(U), src += sizeof(U))
+			{
+				U value;
+				std::memcpy(&value, src, sizeof(U));
+				value = permute_int<U, map>::apply(value);
+				std::memcpy(dst, &value, sizeof(U));
+			}
+		}
+
+#if defined(ENDIAN_X86)
+		template <typename Order, bool Load>
+		ENDIAN_TARGET("ssse3") inline void permute_n_ssse3(uchar* dst, const uchar* src, std::size_t n)
+		{
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(permute_mask_data<Order, Load>()));
+			const std::size_t step = 16 / Order::size;
+
+			std::size_t i = 0;
+
+			for (; i + step <= n; i += step)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * Order::size));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * Order::size), _mm_shuffle_epi8(v, mask));
+			}
+
+			permute_n_generic<Order, Load>(dst + i * Order::size, src + i * Order::size, n - i);
+		}
+
+		template <typename Order, bool Load>
+		ENDIAN_TARGET("avx2") inline void permute_n_avx2(uchar* dst, const uchar* src, std::size_t n)
+		{
+			const __m256i mask = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(permute_mask_data<Order, Load>())));
+			const std::size_t step = 32 / Order::size;
+
+			std::size_t i = 0;
+
+			for (; i + step <= n; i += step)
+			{
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * Order::size));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * Order::size), _mm256_shuffle_epi8(v, mask));
+			}
+
+			permute_n_generic<Order, Load>(dst + i * Order::size, src + i * Order::size, n - i);
+		}
+#elif defined(ENDIAN_NEON) && defined(__aarch64__)
+		template <typename Order, bool Load>
+		inline void permute_n_neon(uchar* dst, const uchar* src, std::size_t n)
+		{
+			const uint8x16_t mask = vld1q_u8(permute_mask_data<Order, Load>());
+			const std::size_t step = 16 / Order::size;
+
+			std::size_t i = 0;
+
+			for (; i + step <= n; i += step)
+			{
+				vst1q_u8(dst + i * Order::size, vqtbl1q_u8(vld1q_u8(src + i * Order::size), mask));
+			}
+
+			permute_n_generic<Order, Load>(dst + i * Order::size, src + i * Order::size, n - i);
+		}
+#endif
+
+		template <typename Order, bool Load>
+		inline void permute_n(void* dst, const void* src, std::size_t n)
+		{
+			static_assert(Order::size == 2 || Order::size == 4 || Order::size == 8 || Order::size == 16, "permuted_copy_n<>: invalid size");
+			static_assert(Order::is_permutation(), "permuted_copy_n<>: invalid byte order (not a permutation)");
+
+			static const bswap_n_func func = []() -> bswap_n_func {
+#if defined(ENDIAN_X86_DISPATCH)
+				__builtin_cpu_init();
+
+				if (__builtin_cpu_supports("avx2"))
+					return permute_n_avx2<Order, Load>;
+				if (__builtin_cpu_supports("ssse3"))
+					return permute_n_ssse3<Order, Load>;
+#elif defined(ENDIAN_X86) && defined(__AVX2__)
+				return permute_n_avx2<Order, Load>;
+#elif defined(ENDIAN_X86) && (defined(__SSSE3__) || defined(__AVX__))
+				return permute_n_ssse3<Order, Load>;
+#elif defined(ENDIAN_NEON) && defined(__aarch64__)
+				return permute_n_neon<Order, Load>;
+#endif
+				return permute_n_generic<Order, Load>;
+			}();
+
+			func(static_cast<uchar*>(dst), static_cast<const uchar*>(src), n);
+		}
+	}
+
+	// Load n values stored with byte permutation Order into native array (bulk, pshufb)
+	template <typename Order, typename T>
+	void permuted_copy_n(T* dst, const void* src, std::size_t n)
+	{
+		static_assert(has_endianness<T>::value && sizeof(T) == Order::size, "permuted_copy_n<>: invalid type");
+		detail::permute_n<Order, true>(dst, src, n);
+	}
+
+	// Store n native values with byte permutation Order
+	template <typename Order, typename T>
+	void permuted_store_n(void* dst, const T* src, std::size_t n)
+	{
+		static_assert(has_endianness<T>::value && sizeof(T) == Order::size, "permuted_store_n<>: invalid type");
+		detail::permute_n<Order, false>(dst, src, n);
+	}
 }
@@ -0,0 +1,176 @@
+/*
+endian_cuda.hpp: CUDA/HIP device-side bulk conversion for endian.hpp
+Copyright (C) 2016-2018 Ivan G. / nekotekina@gmail.com
+This file may be modified and distributed under the terms of the MIT license (see endian.hpp).
+*/
+
+// Requires nvcc or hipcc (otherwise the header is empty). le_t/be_t, le_load/be_store... are usable in device code.
+// std::be_copy_n_device(dst, src, n, stream) -- convert n big endian values in device memory into native array
+// std::be_store_n_device(dst, src, n, stream), std::le_copy_n_device, std::le_store_n_device -- same
+// std::byteswap_inplace_device(ptr, n, stream) -- convert array of le_t/be_t in device memory in place
+// Kernels are launched asynchronously in `stream` (stream ordered after the copy to device memory),
+// the launch error (cudaGetLastError/hipGetLastError) is returned. dst == src is allowed.
+
+#pragma once
+
+#include "endian.hpp"
+
+#if defined(__CUDACC__) || defined(__HIPCC__)
+
+#if defined(__HIPCC__)
+#include <hip/hip_runtime.h>
+#else
+#include <cuda_runtime.h>
+#endif
+
+namespace std
+{
+#if defined(__HIPCC__)
+	using endian_stream_t = hipStream_t;
+	using endian_error_t = hipError_t;
+#else
+	using endian_stream_t = cudaStream_t;
+	using endian_error_t = cudaError_t;
+#endif
+
+	namespace detail
+	{
+		// Grid-stride loop; 16-byte vectors if dst and src are aligned (device allocations are)
+		template <std::size_t Size>
+		__global__ void bswap_n_kernel(uchar* dst, const uchar* src, std::size_t n)
+		{
+			using U = typename uint_of_size<Size>::type;
+			using buf = endian_buffer<U, Size, Size>;
+
+			const std::size_t stride = static_cast<std::size_t>(blockDim.x) * gridDim.x;
+			const std::size_t tid = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+			std::size_t i = tid;
+
+			if ((reinterpret_cast<std::uintptr_t>(dst) | reinterpret_cast<std::uintptr_t>(src)) % 16 == 0)
+			{
+				constexpr std::size_t step = 16 / Size;
+
+				for (; i < n / step; i += stride)
+				{
+					uint4 v = reinterpret_cast<const uint4*>(src)[i];
+					U* e = reinterpret_cast<U*>(&v);
+
+					for (std::size_t j = 0; j < step; j++)
+					{
+						e[j] = buf::swap(e[j]);
+					}
+
+					reinterpret_cast<uint4*>(dst)[i] = v;
+				}
+
+				// Tail (less than one vector)
+				i = n / step * step + tid;
+			}
+
+			for (; i < n; i += stride)
+			{
+				U value;
+				memcpy(&value, src + i * Size, Size);
+				value = buf::swap(value);
+				memcpy(dst + i * Size, &value, Size);
+			}
+		}
+
+		template <std::size_t Size>
+		endian_error_t bswap_n_device(void* dst, const void* src, std::size_t n, endian_stream_t stream)
+		{
+			static_assert(Size == 2 || Size == 4 || Size == 8 || Size == 16, "bswap_n_device<>: invalid size");
+
+			constexpr unsigned threads = 256;
+
+			// Enough blocks to saturate memory bandwidth, each thread handles several vectors
+			const std::size_t vectors = (n * Size + 15) / 16;
+			const std::size_t wanted = (vectors + threads * 4 - 1) / (threads * 4);
+			const unsigned blocks = static_cast<unsigned>(wanted < 65535 ? (wanted ? wanted : 1) : 65535);
+
+			if (n == 0)
+			{
+#if defined(__HIPCC__)
+				return hipSuccess;
+#else
+				return cudaSuccess;
+#endif
+			}
+
+			bswap_n_kernel<Size><<<blocks, threads, 0, stream>>>(static_cast<uchar*>(dst), static_cast<const uchar*>(src), n);
+
+#if defined(__HIPCC__)
+			return hipGetLastError();
+#else
+			return cudaGetLastError();
+#endif
+		}
+
+		// Native order: plain device-to-device copy (no-op if dst == src)
+		template <std::size_t Size>
+		endian_error_t copy_n_device(void* dst, const void* src, std::size_t n, endian_stream_t stream)
+		{
+#if defined(__HIPCC__)
+			return dst == src ? hipSuccess : hipMemcpyAsync(dst, src, n * Size, hipMemcpyDeviceToDevice, stream);
+#else
+			return dst == src ? cudaSuccess : cudaMemcpyAsync(dst, src, n * Size, cudaMemcpyDeviceToDevice, stream);
+#endif
+		}
+
+		template <std::size_t Size>
+		endian_error_t convert_n_device(void* dst, const void* src, std::size_t n, endian_stream_t stream, std::true_type)
+		{
+			return copy_n_device<Size>(dst, src, n, stream);
+		}
+
+		template <std::size_t Size>
+		endian_error_t convert_n_device(void* dst, const void* src, std::size_t n, endian_stream_t stream, std::false_type)
+		{
+			return bswap_n_device<Size>(dst, src, n, stream);
+		}
+
+		// Copy if Native (or single byte), byteswap otherwise
+		template <std::size_t Size, bool Native>
+		endian_error_t convert_n_device(void* dst, const void* src, std::size_t n, endian_stream_t stream)
+		{
+			return convert_n_device<Size>(dst, src, n, stream, std::integral_constant<bool, Native || Size == 1>());
+		}
+	}
+
+	template <typename T>
+	endian_error_t le_copy_n_device(T* dst, const void* src, std::size_t n, endian_stream_t stream = 0)
+	{
+		static_assert(has_endianness<T>::value, "le_copy_n_device<>: invalid type");
+		return detail::convert_n_device<sizeof(T), endian::native == endian::little>(dst, src, n, stream);
+	}
+
+	template <typename T>
+	endian_error_t le_store_n_device(void* dst, const T* src, std::size_t n, endian_stream_t stream = 0)
+	{
+		static_assert(has_endianness<T>::value, "le_store_n_device<>: invalid type");
+		return detail::convert_n_device<sizeof(T), endian::native == endian::little>(dst, src, n, stream);
+	}
+
+	template <typename T>
+	endian_error_t be_copy_n_device(T* dst, const void* src, std::size_t n, endian_stream_t stream = 0)
+	{
+		static_assert(has_endianness<T>::value, "be_copy_n_device<>: invalid type");
+		return detail::convert_n_device<sizeof(T), endian::native == endian::big>(dst, src, n, stream);
+	}
+
+	template <typename T>
+	endian_error_t be_store_n_device(void* dst, const T* src, std::size_t n, endian_stream_t stream = 0)
+	{
+		static_assert(has_endianness<T>::value, "be_store_n_device<>: invalid type");
+		return detail::convert_n_device<sizeof(T), endian::native == endian::big>(dst, src, n, stream);
+	}
+
+	template <typename T, std::size_t A, bool Native>
+	endian_error_t byteswap_inplace_device(endian_base<T, A, Native>* data, std::size_t n, endian_stream_t stream = 0)
+	{
+		static_assert(sizeof(endian_base<T, A, Native>) == sizeof(T), "byteswap_inplace_device<>: over-aligned elements");
+		return detail::convert_n_device<sizeof(T), Native>(data, data, n, stream);
+	}
+}
+
+#endif
@@ -0,0 +1,339 @@
+/*
+endian_ingest.hpp: Pipelined file/socket ingest with overlapped conversion for endian.hpp
+Copyright (C) 2016-2018 Ivan G. / nekotekina@gmail.com
+This file may be modified and distributed under the terms of the MIT license (see endian.hpp).
+*/
+
+// std::ingest_fd<E>(fd, consumer, opts) -- read array of E from file descriptor in chunks, convert and deliver them
+// std::ingest_file<E>(path, consumer, opts) -- same for file (POSIX)
+// Reads are performed by a background thread into a ring of buffers (triple buffering by default),
+// chunk N is converted in place (bulk functions) and passed to consumer while chunk N + 1 is being read.
+// E is le_t/be_t<T> (delivered as T), a record with `endian_fields` (see std::is_wire_ready) delivered as Out
+// (native struct with the same layout, explicit template argument is required), or any other type delivered unchanged.
+// consumer(Out* data, std::size_t count) is called in the calling thread, it may return false to stop.
+// Positional reads (pread) are used for files, sequential reads (read) for sockets and pipes (opts.positional).
+
+#pragma once
+
+#include "endian.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#define ENDIAN_INGEST
+#endif
+
+#if defined(ENDIAN_INGEST)
+
+namespace std
+{
+	struct ingest_options
+	{
+		// Chunk size in bytes (rounded down to whole elements)
+		std::size_t chunk = 1 << 20;
+
+		// Number of buffers (2: double buffering, 3: triple buffering...)
+		unsigned buffers = 3;
+
+		// Use pread from offset (files), or read from current position (sockets, pipes)
+		bool positional = true;
+
+		// Start offset and maximal length in bytes
+		std::uint64_t offset = 0;
+		std::uint64_t length = -1;
+	};
+
+	struct ingest_result
+	{
+		// Number of elements delivered
+		std::uint64_t count = 0;
+
+		// errno value of failed read (0 on success)
+		int error = 0;
+
+		// Stopped by consumer
+		bool stopped = false;
+
+		// Trailing bytes not forming whole element
+		std::size_t tail = 0;
+	};
+
+	namespace detail
+	{
+		// Output type and in-place conversion of E
+		template <typename E, typename = void>
+		struct ingest_element
+		{
+			using type = E;
+
+			static void convert_n(E*, std::size_t)
+			{
+			}
+		};
+
+		template <typename T, std::size_t A, bool Native>
+		struct ingest_element<endian_base<T, A, Native>>
+		{
+			static_assert(sizeof(endian_base<T, A, Native>) == sizeof(T), "ingest<>: over-aligned elements");
+
+			using type = T;
+
+			static void convert_n(endian_base<T, A, Native>* data, std::size_t n)
+			{
+				byteswap_inplace(data, n);
+			}
+		};
+
+		template <typename E>
+		struct ingest_element<E, std::enable_if_t<has_endian_fields<E>::value>>
+		{
+			static_assert(E::endian_fields::size == sizeof(E), "endian_fields: layout mismatch");
+
+			// No native type: Out must be given explicitly (see ingest_fd)
+			using type = E;
+
+			// Native layout of the record (fields are stored as native values)
+			static void convert_n(E* data, std::size_t n)
+			{
+				E::endian_fields::convert_n(data, data, n);
+			}
+		};
+
+		template <typename F, typename Out>
+		bool ingest_call(F& func, Out* data, std::size_t n, std::true_type)
+		{
+			return func(data, n);
+		}
+
+		template <typename F, typename Out>
+		bool ingest_call(F& func, Out* data, std::size_t n, std::false_type)
+		{
+			func(data, n);
+			return true;
+		}
+
+		// Ring of buffers shared between reader thread and consumer
+		class ingest_ring
+		{
+			struct slot
+			{
+				std::vector<uchar> data;
+				std::size_t size = 0;
+				bool full = false;
+			};
+
+			std::vector<slot> m_slots;
+			std::mutex m_mutex;
+			std::condition_variable m_cv;
+
+			// Reader finished (EOF, error or stop)
+			bool m_done = false;
+			bool m_stop = false;
+			int m_error = 0;
+
+		public:
+			ingest_ring(unsigned count, std::size_t size)
+				: m_slots(count < 2 ? 2 : count)
+			{
+				for (auto& s : m_slots)
+				{
+					s.data.resize(size);
+				}
+			}
+
+			// Reader: fill slots in order until EOF, error or stop
+			void read(int fd, const ingest_options& opts, std::size_t chunk)
+			{
+				std::uint64_t pos = opts.offset;
+				std::uint64_t left = opts.length;
+
+				for (std::size_t i = 0;; i = (i + 1) % m_slots.size())
+				{
+					slot& s = m_slots[i];
+
+					{
+						std::unique_lock<std::mutex> lock(m_mutex);
+						m_cv.wait(lock, [&] { return !s.full || m_stop; });
+
+						if (m_stop)
+						{
+							break;
+						}
+					}
+
+					// Read whole chunk unless EOF (short reads are continued)
+					std::size_t size = 0;
+					int error = 0;
+					const std::size_t want = left < chunk ? static_cast<std::size_t>(left) : chunk;
+
+					while (size < want)
+					{
+						const ::ssize_t r = opts.positional ? ::pread(fd, s.data.data() + size, want - size, static_cast<::off_t>(pos)) : ::read(fd, s.data.data() + size, want - size);
+
+						if (r < 0 && errno == EINTR)
+						{
+							continue;
+						}
+
+						if (r <= 0)
+						{
+							error = r < 0 ? errno : 0;
+							break;
+						}
+
+						size += static_cast<std::size_t>(r);
+						pos += static_cast<std::size_t>(r);
+					}
+
+					left -= size;
+
+					std::lock_guard<std::mutex> lock(m_mutex);
+					s.size = size;
+					s.full = true;
+					m_cv.notify_all();
+
+					if (size < want || left == 0)
+					{
+						m_error = error;
+						break;
+					}
+				}
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_done = true;
+				m_cv.notify_all();
+			}
+
+			// Consumer: wait for slot i, returns its data and size (nullptr if no more data)
+			uchar* acquire(std::size_t i, std::size_t& size)
+			{
+				slot& s = m_slots[i % m_slots.size()];
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_cv.wait(lock, [&] { return s.full || m_done; });
+
+				if (!s.full)
+				{
+					return nullptr;
+				}
+
+				size = s.size;
+				return s.data.data();
+			}
+
+			void release(std::size_t i)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_slots[i % m_slots.size()].full = false;
+				m_cv.notify_all();
+			}
+
+			void stop()
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
+				m_cv.notify_all();
+			}
+
+			int error()
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_error;
+			}
+		};
+	}
+
+	template <typename E, typename Out = typename detail::ingest_element<E>::type, typename F>
+	ingest_result ingest_fd(int fd, F&& consumer, const ingest_options& opts = {})
+	{
+		static_assert(std::is_trivially_copyable<E>::value && sizeof(Out) == sizeof(E), "ingest_fd<>: invalid type");
+
+		// Converted records hold native values, reading them through LE/BE fields would swap again
+		static_assert(!detail::has_endian_fields<E>::value || !std::is_same<Out, E>::value, "ingest_fd<>: records require explicit native Out type");
+
+		using element = detail::ingest_element<E>;
+		using returns_bool = std::is_same<decltype(consumer(std::declval<Out*>(), std::size_t{})), bool>;
+
+		// Whole elements per chunk (only the last chunk may be partial)
+		const std::size_t chunk = opts.chunk / sizeof(E) ? opts.chunk / sizeof(E) * sizeof(E) : sizeof(E);
+
+		ingest_result result;
+		detail::ingest_ring ring(opts.buffers, chunk);
+
+		std::thread reader([&] { ring.read(fd, opts, chunk); });
+
+		// Stop and join reader on exit, also on exception from consumer (waits for pending read to complete)
+		struct join_guard
+		{
+			detail::ingest_ring& ring;
+			std::thread& thread;
+
+			~join_guard()
+			{
+				ring.stop();
+				thread.join();
+			}
+		} guard{ring, reader};
+
+		for (std::size_t i = 0;; i++)
+		{
+			std::size_t size = 0;
+			detail::uchar* data = ring.acquire(i, size);
+
+			if (!data)
+			{
+				break;
+			}
+
+			const std::size_t count = size / sizeof(E);
+			result.tail = size % sizeof(E);
+
+			if (count)
+			{
+				element::convert_n(reinterpret_cast<E*>(data), count);
+
+				result.count += count;
+
+				if (!detail::ingest_call(consumer, reinterpret_cast<Out*>(data), count, returns_bool()))
+				{
+					result.stopped = true;
+					break;
+				}
+			}
+
+			ring.release(i);
+		}
+
+		result.error = ring.error();
+		return result;
+	}
+
+	template <typename E, typename Out = typename detail::ingest_element<E>::type, typename F>
+	ingest_result ingest_file(const char* path, F&& consumer, ingest_options opts = {})
+	{
+		ingest_result result;
+
+		const int fd = ::open(path, O_RDONLY);
+
+		if (fd < 0)
+		{
+			result.error = errno;
+			return result;
+		}
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+		::posix_fadvise(fd, static_cast<::off_t>(opts.offset), 0, POSIX_FADV_SEQUENTIAL);
+#endif
+		opts.positional = true;
+		result = ingest_fd<E, Out>(fd, std::forward<F>(consumer), opts);
+		::close(fd);
+		return result;
+	}
+}
+
+#endif
@@ -0,0 +1,442 @@
+/*
+endian_mapped.hpp: Zero-copy views of LE/BE arrays in memory-mapped files for endian.hpp
+Copyright (C) 2016-2018 Ivan G. / nekotekina@gmail.com
+This file may be modified and distributed under the terms of the MIT license (see endian.hpp).
+*/
+
+// std::endian_mapped_array<E> -- read-only view of array of E (le_t/be_t or struct of them) in memory
+// std::endian_mapped_array<E>(ptr, bytes) -- view of existing memory (not owned)
+// std::endian_mapped_array<E>::map_file(path, opts) -- map whole file (POSIX), empty array on failure
+// Elements are decoded on access: operator[] and iterators return T by value for endian_base<T, ...>,
+// and a copy of E for other types (records). E should have alignment 1 (like be_t<T, 1>) for packed data.
+// copy_n(dst, pos, count) decodes sub-range with bulk functions, advise() passes hints to madvise.
+
+#pragma once
+
+#include "endian.hpp"
+
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define ENDIAN_MMAP
+#endif
+
+namespace std
+{
+	// Access pattern hint for endian_mapped_array::advise
+	enum class map_advice
+	{
+		normal,
+		sequential,
+		random,
+		willneed,
+		dontneed,
+	};
+
+	struct map_options
+	{
+		// Initial hint
+		map_advice advice = map_advice::normal;
+
+		// Request transparent huge pages (if supported by OS and filesystem)
+		bool huge_pages = false;
+
+		// Prefault pages on mapping
+		bool populate = false;
+	};
+
+	namespace detail
+	{
+		// Element access: plain copy of element by default
+		template <typename E>
+		struct mapped_element
+		{
+			static_assert(std::is_trivially_copyable<E>::value, "endian_mapped_array<>: invalid type");
+
+			using value_type = E;
+
+			static value_type get(const uchar* ptr)
+			{
+				E result;
+				std::memcpy(&result, ptr, sizeof(E));
+				return result;
+			}
+
+			static void copy_n(value_type* dst, const uchar* src, std::size_t n)
+			{
+				std::memcpy(dst, src, n * sizeof(E));
+			}
+		};
+
+		template <typename T, std::size_t A, bool Native>
+		struct mapped_element<endian_base<T, A, Native>>
+		{
+			static_assert(sizeof(endian_base<T, A, Native>) == sizeof(T), "endian_mapped_array<>: over-aligned elements");
+
+			using value_type = T;
+
+			static value_type get(const uchar* ptr)
+			{
+				// Copy is optimized out (unaligned load + bswap)
+				endian_base<T, A, Native> result;
+				std::memcpy(&result, ptr, sizeof(T));
+				return result;
+			}
+
+			static void copy_n(value_type* dst, const uchar* src, std::size_t n)
+			{
+				Native ? copy_n_ne<sizeof(T)>(dst, src, n) : copy_n_re<sizeof(T)>(dst, src, n);
+			}
+		};
+
+#if defined(ENDIAN_MMAP)
+		inline int map_advice_flag(map_advice advice)
+		{
+			switch (advice)
+			{
+			case map_advice::sequential: return MADV_SEQUENTIAL;
+			case map_advice::random: return MADV_RANDOM;
+			case map_advice::willneed: return MADV_WILLNEED;
+			case map_advice::dontneed: return MADV_DONTNEED;
+			default: return MADV_NORMAL;
+			}
+		}
+#endif
+	}
+
+	template <typename E>
+	class endian_mapped_array
+	{
+		using element = detail::mapped_element<E>;
+
+		const detail::uchar* m_data = nullptr;
+		std::size_t m_size = 0;
+
+		// Owned mapping (if any)
+		void* m_map = nullptr;
+		std::size_t m_map_size = 0;
+
+	public:
+		using value_type = typename element::value_type;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		class iterator
+		{
+			const detail::uchar* ptr = nullptr;
+
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = typename element::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = value_type;
+
+			iterator() = default;
+
+			explicit iterator(const detail::uchar* ptr)
+				: ptr(ptr)
+			{
+			}
+
+			value_type operator*() const
+			{
+				return element::get(ptr);
+			}
+
+			value_type operator[](difference_type i) const
+			{
+				return element::get(ptr + i * static_cast<difference_type>(sizeof(E)));
+			}
+
+			// Raw element address
+			const E* base() const
+			{
+				return reinterpret_cast<const E*>(ptr);
+			}
+
+			iterator& operator++()
+			{
+				ptr += sizeof(E);
+				return *this;
+			}
+
+			iterator& operator--()
+			{
+				ptr -= sizeof(E);
+				return *this;
+			}
+
+			iterator operator++(int)
+			{
+				iterator r = *this;
+				ptr += sizeof(E);
+				return r;
+			}
+
+			iterator operator--(int)
+			{
+				iterator r = *this;
+				ptr -= sizeof(E);
+				return r;
+			}
+
+			iterator& operator+=(difference_type n)
+			{
+				ptr += n * static_cast<difference_type>(sizeof(E));
+				return *this;
+			}
+
+			iterator& operator-=(difference_type n)
+			{
+				ptr -= n * static_cast<difference_type>(sizeof(E));
+				return *this;
+			}
+
+			friend iterator operator+(iterator it, difference_type n)
+			{
+				return it += n;
+			}
+
+			friend iterator operator+(difference_type n, iterator it)
+			{
+				return it += n;
+			}
+
+			friend iterator operator-(iterator it, difference_type n)
+			{
+				return it -= n;
+			}
+
+			friend difference_type operator-(const iterator& lhs, const iterator& rhs)
+			{
+				return (lhs.ptr - rhs.ptr) / static_cast<difference_type>(sizeof(E));
+			}
+
+			friend bool operator==(const iterator& lhs, const iterator& rhs)
+			{
+				return lhs.ptr == rhs.ptr;
+			}
+
+			friend bool operator!=(const iterator& lhs, const iterator& rhs)
+			{
+				return lhs.ptr != rhs.ptr;
+			}
+
+			friend bool operator<(const iterator& lhs, const iterator& rhs)
+			{
+				return lhs.ptr < rhs.ptr;
+			}
+
+			friend bool operator>(const iterator& lhs, const iterator& rhs)
+			{
+				return lhs.ptr > rhs.ptr;
+			}
+
+			friend bool operator<=(const iterator& lhs, const iterator& rhs)
+			{
+				return lhs.ptr <= rhs.ptr;
+			}
+
+			friend bool operator>=(const iterator& lhs, const iterator& rhs)
+			{
+				return lhs.ptr >= rhs.ptr;
+			}
+		};
+
+		using const_iterator = iterator;
+
+		endian_mapped_array() = default;
+
+		// View of existing memory (trailing partial element is ignored)
+		endian_mapped_array(const void* data, std::size_t bytes)
+			: m_data(static_cast<const detail::uchar*>(data))
+			, m_size(bytes / sizeof(E))
+		{
+		}
+
+		endian_mapped_array(const endian_mapped_array&) = delete;
+
+		endian_mapped_array(endian_mapped_array&& rhs) noexcept
+			: m_data(rhs.m_data)
+			, m_size(rhs.m_size)
+			, m_map(rhs.m_map)
+			, m_map_size(rhs.m_map_size)
+		{
+			rhs.m_data = nullptr;
+			rhs.m_size = 0;
+			rhs.m_map = nullptr;
+			rhs.m_map_size = 0;
+		}
+
+		endian_mapped_array& operator=(endian_mapped_array rhs) noexcept
+		{
+			std::swap(m_data, rhs.m_data);
+			std::swap(m_size, rhs.m_size);
+			std::swap(m_map, rhs.m_map);
+			std::swap(m_map_size, rhs.m_map_size);
+			return *this;
+		}
+
+		~endian_mapped_array()
+		{
+#if defined(ENDIAN_MMAP)
+			if (m_map)
+			{
+				::munmap(m_map, m_map_size);
+			}
+#endif
+		}
+
+#if defined(ENDIAN_MMAP)
+		// Map whole file read-only (returns empty array on failure, check errno)
+		static endian_mapped_array map_file(const char* path, const map_options& opts = {})
+		{
+			endian_mapped_array result;
+
+			const int fd = ::open(path, O_RDONLY);
+
+			if (fd < 0)
+			{
+				return result;
+			}
+
+			struct ::stat st;
+
+			if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+			{
+				::close(fd);
+				return result;
+			}
+
+			int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+			if (opts.populate)
+				flags |= MAP_POPULATE;
+#endif
+
+			const std::size_t size = static_cast<std::size_t>(st.st_size);
+			void* map = ::mmap(nullptr, size, PROT_READ, flags, fd, 0);
+			::close(fd);
+
+			if (map == MAP_FAILED)
+			{
+				return result;
+			}
+
+			result.m_data = static_cast<const detail::uchar*>(map);
+			result.m_size = size / sizeof(E);
+			result.m_map = map;
+			result.m_map_size = size;
+
+#if defined(MADV_HUGEPAGE)
+			if (opts.huge_pages)
+				::madvise(map, size, MADV_HUGEPAGE);
+#endif
+			if (opts.advice != map_advice::normal)
+				result.advise(opts.advice);
+
+			return result;
+		}
+
+		// Access pattern hint for count elements from pos (whole array by default)
+		bool advise(map_advice advice, std::size_t pos = 0, std::size_t count = -1) const
+		{
+			if (pos >= m_size)
+			{
+				return false;
+			}
+
+			if (count > m_size - pos)
+			{
+				count = m_size - pos;
+			}
+
+			// Round to whole pages
+			const std::uintptr_t page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+			const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(m_data + pos * sizeof(E)) / page * page;
+			const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(m_data + (pos + count) * sizeof(E));
+
+			return ::madvise(reinterpret_cast<void*>(begin), end - begin, detail::map_advice_flag(advice)) == 0;
+		}
+#endif
+
+		std::size_t size() const
+		{
+			return m_size;
+		}
+
+		bool empty() const
+		{
+			return m_size == 0;
+		}
+
+		// Raw elements
+		const E* data() const
+		{
+			return reinterpret_cast<const E*>(m_data);
+		}
+
+		iterator begin() const
+		{
+			return iterator(m_data);
+		}
+
+		iterator end() const
+		{
+			return iterator(m_data + m_size * sizeof(E));
+		}
+
+		value_type operator[](std::size_t index) const
+		{
+			return element::get(m_data + index * sizeof(E));
+		}
+
+		value_type front() const
+		{
+			return element::get(m_data);
+		}
+
+		value_type back() const
+		{
+			return element::get(m_data + (m_size - 1) * sizeof(E));
+		}
+
+		// View of count elements from pos (not owned, must not outlive the array)
+		endian_mapped_array subview(std::size_t pos, std::size_t count = -1) const
+		{
+			if (pos > m_size)
+			{
+				pos = m_size;
+			}
+
+			if (count > m_size - pos)
+			{
+				count = m_size - pos;
+			}
+
+			return endian_mapped_array(m_data + pos * sizeof(E), count * sizeof(E));
+		}
+
+		// Decode count elements from pos (bulk), returns number of elements copied
+		std::size_t copy_n(value_type* dst, std::size_t pos, std::size_t count) const
+		{
+			if (pos >= m_size)
+			{
+				return 0;
+			}
+
+			if (count > m_size - pos)
+			{
+				count = m_size - pos;
+			}
+
+			element::copy_n(dst, m_data + pos * sizeof(E), count);
+			return count;
+		}
+	};
+}
@@ -0,0 +1,302 @@
+/*
+endian_parallel.hpp: Multithreaded bulk conversion for endian.hpp
+Copyright (C) 2016-2018 Ivan G. / nekotekina@gmail.com
+This file may be modified and distributed under the terms of the MIT license (see endian.hpp).
+*/
+
+// std::be_copy_n(exec, dst, src, n) -- same as be_copy_n(dst, src, n), split into chunks executed by `exec`
+// std::be_store_n(exec, dst, src, n), std::le_copy_n(exec, ...), std::le_store_n(exec, ...) -- same
+// std::byteswap_inplace(exec, ptr, n) -- same
+// Executor is a function object called as exec(count, task) which must call task(i) for every i < count
+// (possibly in parallel) and return after all of them are complete. std::endian_executor is the default one:
+// persistent threads (created on first use) take chunks dynamically from a shared counter (no per-thread queues),
+// nested or concurrent calls run in the calling thread, the first exception thrown by a task is rethrown.
+// Small ranges (less than parallel_options::threshold bytes) are converted in the calling thread.
+
+#pragma once
+
+#include "endian.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace std
+{
+	struct parallel_options
+	{
+		// Minimal size in bytes for parallel conversion
+		std::size_t threshold = 4 << 20;
+
+		// Approximate chunk size in bytes (rounded to whole pages)
+		std::size_t chunk = 1 << 20;
+
+		// Store mode (automatic: decided by the total size)
+		bulk_store store = bulk_store::automatic;
+	};
+
+	namespace detail
+	{
+		// Persistent worker threads shared by all endian_executor instances (created on first use)
+		class endian_pool
+		{
+			struct job
+			{
+				void (*call)(void* ctx, std::size_t i);
+				void* ctx;
+				std::size_t count;
+				std::atomic<std::size_t> next{0};
+
+				// Number of pool threads which may still join
+				unsigned workers;
+
+				// First exception thrown by task
+				std::exception_ptr error;
+			};
+
+			std::vector<std::thread> m_threads;
+			std::mutex m_mutex;
+			std::condition_variable m_cv;
+			std::condition_variable m_done_cv;
+			job* m_job = nullptr;
+			unsigned m_active = 0;
+			bool m_stop = false;
+
+			// Set while a job is running (nested and concurrent calls run in the calling thread)
+			std::atomic<bool> m_busy{false};
+
+			// Take tasks dynamically (in order) until all of them are taken, remaining tasks are skipped on exception
+			void work(job& j)
+			{
+				try
+				{
+					for (std::size_t i; (i = j.next++) < j.count;)
+					{
+						j.call(j.ctx, i);
+					}
+				}
+				catch (...)
+				{
+					j.next = j.count;
+
+					std::lock_guard<std::mutex> lock(m_mutex);
+
+					if (!j.error)
+					{
+						j.error = std::current_exception();
+					}
+				}
+			}
+
+			void worker()
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+
+				while (true)
+				{
+					m_cv.wait(lock, [&] { return m_stop || (m_job && m_job->workers); });
+
+					if (m_stop)
+					{
+						return;
+					}
+
+					job& j = *m_job;
+					j.workers--;
+					m_active++;
+
+					lock.unlock();
+					work(j);
+					lock.lock();
+
+					if (--m_active == 0)
+					{
+						m_done_cv.notify_all();
+					}
+				}
+			}
+
+		public:
+			endian_pool() = default;
+
+			endian_pool(const endian_pool&) = delete;
+
+			~endian_pool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_stop = true;
+					m_cv.notify_all();
+				}
+
+				for (auto& thread : m_threads)
+				{
+					thread.join();
+				}
+			}
+
+			static endian_pool& instance()
+			{
+				static endian_pool pool;
+				return pool;
+			}
+
+			// Call task(i) for every i < count using up to `threads` threads (including the calling one)
+			template <typename F>
+			void run(std::size_t count, unsigned threads, F& task)
+			{
+				if (threads < 2 || count < 2 || m_busy.exchange(true))
+				{
+					for (std::size_t i = 0; i < count; i++)
+					{
+						task(i);
+					}
+
+					return;
+				}
+
+				job j;
+				j.call = [](void* ctx, std::size_t i) { (*static_cast<F*>(ctx))(i); };
+				j.ctx = &task;
+				j.count = count;
+				j.workers = static_cast<unsigned>(count - 1 < threads - 1 ? count - 1 : threads - 1);
+
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+
+					while (m_threads.size() < j.workers)
+					{
+						m_threads.emplace_back([this] { worker(); });
+					}
+
+					m_job = &j;
+					m_cv.notify_all();
+				}
+
+				work(j);
+
+				// Withdraw the job and wait for joined threads
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_job = nullptr;
+					m_done_cv.wait(lock, [&] { return m_active == 0; });
+					m_busy = false;
+				}
+
+				if (j.error)
+				{
+					std::rethrow_exception(j.error);
+				}
+			}
+		};
+	}
+
+	// Default executor: runs tasks on persistent pool threads, which take chunks dynamically from a shared counter
+	struct endian_executor
+	{
+		unsigned threads = std::thread::hardware_concurrency();
+
+		template <typename F>
+		void operator()(std::size_t count, F&& task) const
+		{
+			detail::endian_pool::instance().run(count, threads, task);
+		}
+	};
+
+	namespace detail
+	{
+		// Split n elements of given size into chunks and call func(dst, src, count, mode) for each chunk
+		template <std::size_t Size, typename Exec, typename F>
+		void parallel_n(Exec&& exec, void* dst, const void* src, std::size_t n, const parallel_options& opts, F func)
+		{
+			bulk_store mode = opts.store;
+
+			if (mode == bulk_store::automatic)
+			{
+				mode = n * Size >= ENDIAN_STREAM_THRESHOLD ? bulk_store::streaming : bulk_store::temporal;
+			}
+
+			if (n * Size < opts.threshold || n * Size <= opts.chunk)
+			{
+				func(dst, src, n, mode);
+				return;
+			}
+
+			// Chunks are multiple of page size and SIMD width if possible
+			constexpr std::size_t page = 4096;
+			constexpr std::size_t unit = page % Size == 0 ? page / Size : 1;
+
+			// At least one unit (also for opts.chunk == 0)
+			const std::size_t per_chunk = opts.chunk / Size > unit ? (opts.chunk / Size + unit - 1) / unit * unit : unit;
+			const std::size_t count = (n + per_chunk - 1) / per_chunk;
+
+			exec(count, [&](std::size_t i) {
+				const std::size_t start = i * per_chunk;
+				const std::size_t size = n - start < per_chunk ? n - start : per_chunk;
+				func(static_cast<uchar*>(dst) + start * Size, static_cast<const uchar*>(src) + start * Size, size, mode);
+			});
+		}
+	}
+
+#ifdef __BIG_ENDIAN__
+#define LE_COPY_N copy_n_re
+#define BE_COPY_N copy_n_ne
+#else
+#define LE_COPY_N copy_n_ne
+#define BE_COPY_N copy_n_re
+#endif
+
+	template <typename Exec, typename T>
+	void le_copy_n(Exec&& exec, T* dst, const void* src, std::size_t n, const parallel_options& opts = {})
+	{
+		static_assert(has_endianness<T>::value, "le_copy_n<>: invalid type");
+		detail::parallel_n<sizeof(T)>(exec, dst, src, n, opts, detail::LE_COPY_N<sizeof(T)>);
+	}
+
+	template <typename Exec, typename T>
+	void le_store_n(Exec&& exec, void* dst, const T* src, std::size_t n, const parallel_options& opts = {})
+	{
+		static_assert(has_endianness<T>::value, "le_store_n<>: invalid type");
+		detail::parallel_n<sizeof(T)>(exec, dst, src, n, opts, detail::LE_COPY_N<sizeof(T)>);
+	}
+
+	template <typename Exec, typename T>
+	void be_copy_n(Exec&& exec, T* dst, const void* src, std::size_t n, const parallel_options& opts = {})
+	{
+		static_assert(has_endianness<T>::value, "be_copy_n<>: invalid type");
+		detail::parallel_n<sizeof(T)>(exec, dst, src, n, opts, detail::BE_COPY_N<sizeof(T)>);
+	}
+
+	template <typename Exec, typename T>
+	void be_store_n(Exec&& exec, void* dst, const T* src, std::size_t n, const parallel_options& opts = {})
+	{
+		static_assert(has_endianness<T>::value, "be_store_n<>: invalid type");
+		detail::parallel_n<sizeof(T)>(exec, dst, src, n, opts, detail::BE_COPY_N<sizeof(T)>);
+	}
+
+#undef LE_COPY_N
+#undef BE_COPY_N
+
+	template <typename Exec, typename T, std::size_t A, bool Native>
+	T* byteswap_inplace(Exec&& exec, endian_base<T, A, Native>* data, std::size_t n, const parallel_options& opts = {})
+	{
+		static_assert(sizeof(endian_base<T, A, Native>) == sizeof(T), "byteswap_inplace<>: over-aligned elements");
+
+		if (!Native)
+		{
+			// In place: temporal stores unless streaming is requested explicitly
+			parallel_options inplace = opts;
+
+			if (inplace.store == bulk_store::automatic)
+			{
+				inplace.store = bulk_store::temporal;
+			}
+
+			detail::parallel_n<sizeof(T)>(exec, data, data, n, inplace, detail::copy_n_re<sizeof(T)>);
+		}
+
+		return reinterpret_cast<T*>(data);
+	}
+}
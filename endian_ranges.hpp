@@ -0,0 +1,319 @@
+/*
+endian_ranges.hpp: C++20 range adaptors for endian.hpp
+Copyright (C) 2016-2018 Ivan G. / nekotekina@gmail.com
+This file may be modified and distributed under the terms of the MIT license (see endian.hpp).
+*/
+
+// data | std::views::from_be -- lazy view of native values over contiguous range of be_t<T> (also from_le)
+// data | std::views::to_be -- lazy view of be_t<T> values over contiguous range of native T (also to_le)
+// Random access iteration converts one element at a time (by value). For bulk processing:
+// view.copy_to(out) -- convert whole range with bulk functions (SIMD)
+// view.chunks(n) -- input range of std::span<const value_type> of up to n elements converted with bulk functions,
+// for (auto chunk : view.chunks()) sum = std::reduce(chunk.begin(), chunk.end(), sum); -- vectorizable inner loop
+
+#pragma once
+
+#include "endian.hpp"
+
+#if defined(__cpp_lib_span) && __has_include(<ranges>)
+#include <ranges>
+#endif
+
+#if defined(__cpp_lib_ranges) && defined(__cpp_lib_span)
+
+namespace std
+{
+	// Lazy conversion view: In elements in memory converted to Out values (one of them is endian_base<T, A, Native>)
+	template <typename In, typename Out, typename T, bool Native>
+	class endian_convert_view : public std::ranges::view_interface<endian_convert_view<In, Out, T, Native>>
+	{
+		static_assert(sizeof(In) == sizeof(T) && sizeof(Out) == sizeof(T), "endian_convert_view<>: over-aligned elements");
+
+		const In* m_data = nullptr;
+		std::size_t m_size = 0;
+
+		// Bulk conversion (dst == src is allowed)
+		static void convert_n(Out* dst, const In* src, std::size_t n)
+		{
+			Native ? detail::copy_n_ne<sizeof(T)>(dst, src, n) : detail::copy_n_re<sizeof(T)>(dst, src, n);
+		}
+
+	public:
+		using value_type = Out;
+
+		class iterator
+		{
+			const In* ptr = nullptr;
+
+		public:
+			using iterator_concept = std::random_access_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+			using value_type = Out;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() = default;
+
+			explicit iterator(const In* ptr)
+				: ptr(ptr)
+			{
+			}
+
+			Out operator*() const
+			{
+				return static_cast<Out>(static_cast<T>(*ptr));
+			}
+
+			Out operator[](difference_type i) const
+			{
+				return static_cast<Out>(static_cast<T>(ptr[i]));
+			}
+
+			iterator& operator++()
+			{
+				++ptr;
+				return *this;
+			}
+
+			iterator& operator--()
+			{
+				--ptr;
+				return *this;
+			}
+
+			iterator operator++(int)
+			{
+				return iterator(ptr++);
+			}
+
+			iterator operator--(int)
+			{
+				return iterator(ptr--);
+			}
+
+			iterator& operator+=(difference_type n)
+			{
+				ptr += n;
+				return *this;
+			}
+
+			iterator& operator-=(difference_type n)
+			{
+				ptr -= n;
+				return *this;
+			}
+
+			friend iterator operator+(iterator it, difference_type n)
+			{
+				return it += n;
+			}
+
+			friend iterator operator+(difference_type n, iterator it)
+			{
+				return it += n;
+			}
+
+			friend iterator operator-(iterator it, difference_type n)
+			{
+				return it -= n;
+			}
+
+			friend difference_type operator-(const iterator& lhs, const iterator& rhs)
+			{
+				return lhs.ptr - rhs.ptr;
+			}
+
+			friend bool operator==(const iterator&, const iterator&) = default;
+			friend auto operator<=>(const iterator&, const iterator&) = default;
+
+			// Storage address
+			const In* base() const
+			{
+				return ptr;
+			}
+		};
+
+		// Input range of converted chunks (std::span<const Out>), uses internal buffer
+		class chunk_range
+		{
+			const In* m_data;
+			std::size_t m_size;
+			std::vector<Out> m_buf;
+
+		public:
+			class iterator
+			{
+				chunk_range* range = nullptr;
+				std::size_t pos = 0;
+				std::size_t count = 0;
+
+				void fill()
+				{
+					count = range->m_size - pos < range->m_buf.size() ? range->m_size - pos : range->m_buf.size();
+					convert_n(range->m_buf.data(), range->m_data + pos, count);
+				}
+
+			public:
+				using iterator_concept = std::input_iterator_tag;
+				using value_type = std::span<const Out>;
+				using difference_type = std::ptrdiff_t;
+
+				iterator() = default;
+
+				explicit iterator(chunk_range* range)
+					: range(range)
+				{
+					fill();
+				}
+
+				std::span<const Out> operator*() const
+				{
+					return {range->m_buf.data(), count};
+				}
+
+				iterator& operator++()
+				{
+					pos += count;
+					fill();
+					return *this;
+				}
+
+				void operator++(int)
+				{
+					++*this;
+				}
+
+				friend bool operator==(const iterator& it, std::default_sentinel_t)
+				{
+					return it.count == 0;
+				}
+			};
+
+			chunk_range(const In* data, std::size_t size, std::size_t chunk)
+				: m_data(data)
+				, m_size(size)
+				, m_buf(chunk ? chunk : 1)
+			{
+			}
+
+			iterator begin()
+			{
+				return iterator(this);
+			}
+
+			std::default_sentinel_t end() const
+			{
+				return {};
+			}
+		};
+
+		endian_convert_view() = default;
+
+		endian_convert_view(const In* data, std::size_t size)
+			: m_data(data)
+			, m_size(size)
+		{
+		}
+
+		iterator begin() const
+		{
+			return iterator(m_data);
+		}
+
+		iterator end() const
+		{
+			return iterator(m_data + m_size);
+		}
+
+		std::size_t size() const
+		{
+			return m_size;
+		}
+
+		// Storage
+		const In* data() const
+		{
+			return m_data;
+		}
+
+		Out operator[](std::size_t index) const
+		{
+			return static_cast<Out>(static_cast<T>(m_data[index]));
+		}
+
+		// Convert all elements (bulk), returns end of output
+		Out* copy_to(Out* dst) const
+		{
+			convert_n(dst, m_data, m_size);
+			return dst + m_size;
+		}
+
+		// Converted chunks of up to `chunk` elements
+		chunk_range chunks(std::size_t chunk = 1024) const
+		{
+			return chunk_range(m_data, m_size, chunk);
+		}
+	};
+
+	template <typename In, typename Out, typename T, bool Native>
+	inline constexpr bool ranges::enable_borrowed_range<endian_convert_view<In, Out, T, Native>> = true;
+
+	namespace detail
+	{
+		// Range adaptor: contiguous range of endian_base<T, A, N> to native values
+		template <bool Native>
+		struct from_endian_fn
+		{
+			template <typename T, std::size_t A>
+			static auto make(const endian_base<T, A, Native>* data, std::size_t size)
+			{
+				return endian_convert_view<endian_base<T, A, Native>, T, T, Native>(data, size);
+			}
+
+			template <std::ranges::contiguous_range R>
+			auto operator()(R&& range) const
+			{
+				return make(std::ranges::data(range), std::ranges::size(range));
+			}
+
+			template <std::ranges::contiguous_range R>
+			friend auto operator|(R&& range, const from_endian_fn& fn)
+			{
+				return fn(std::forward<R>(range));
+			}
+		};
+
+		// Range adaptor: contiguous range of native values to endian_base<T, alignof(T), N>
+		template <bool Native>
+		struct to_endian_fn
+		{
+			template <typename T>
+			static auto make(const T* data, std::size_t size)
+			{
+				static_assert(has_endianness<T>::value, "to_be/to_le: invalid type");
+				return endian_convert_view<T, endian_base<T, alignof(T), Native>, T, Native>(data, size);
+			}
+
+			template <std::ranges::contiguous_range R>
+			auto operator()(R&& range) const
+			{
+				return make(std::ranges::data(range), std::ranges::size(range));
+			}
+
+			template <std::ranges::contiguous_range R>
+			friend auto operator|(R&& range, const to_endian_fn& fn)
+			{
+				return fn(std::forward<R>(range));
+			}
+		};
+	}
+
+	namespace ranges::views
+	{
+		inline constexpr detail::from_endian_fn<endian::native == endian::little> from_le{};
+		inline constexpr detail::from_endian_fn<endian::native == endian::big> from_be{};
+		inline constexpr detail::to_endian_fn<endian::native == endian::little> to_le{};
+		inline constexpr detail::to_endian_fn<endian::native == endian::big> to_be{};
+	}
+}
+
+#endif